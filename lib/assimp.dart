@@ -47,17 +47,36 @@ library assimp;
 export 'src/animation.dart';
 export 'src/animesh.dart';
 export 'src/assimp.dart';
+export 'src/batch.dart';
+export 'src/bvh.dart';
+export 'src/cache.dart';
+export 'src/cached.dart';
 export 'src/camera.dart';
+export 'src/codec.dart';
 export 'src/export.dart';
 export 'src/import.dart';
 export 'src/extensions.dart';
+export 'src/filesystem.dart';
+export 'src/hierarchy.dart';
 export 'src/light.dart';
+export 'src/logstream.dart';
+export 'src/lookup.dart';
 export 'src/material.dart';
+export 'src/mattable.dart';
 export 'src/meminfo.dart';
 export 'src/mesh.dart';
+export 'src/meshopt.dart';
 export 'src/metadata.dart';
+export 'src/mmap.dart';
+export 'src/names.dart';
 export 'src/node.dart';
+export 'src/pool.dart';
+export 'src/prefetch.dart';
 export 'src/process.dart';
+export 'src/profile.dart';
 export 'src/properties.dart';
+export 'src/sampler.dart';
 export 'src/scene.dart';
+export 'src/simplify.dart';
 export 'src/texture.dart';
+export 'src/vertex.dart';
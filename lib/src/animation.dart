@@ -113,7 +113,10 @@ class NodeAnim extends AssimpType<aiNodeAnim> {
     return NodeAnim._(ptr);
   }
 
-  String get name => AssimpString.fromNative(_nodeAnim.mNodeName);
+  String get name {
+    // mNodeName is the first member of aiNodeAnim.
+    return AssimpString.fromPointer(ptr.cast());
+  }
 
   Iterable<VectorKey> get positionKeys {
     return Iterable.generate(
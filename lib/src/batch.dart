@@ -0,0 +1,287 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:io';
+
+import 'assimp.dart';
+import 'export.dart';
+import 'logstream.dart';
+import 'meminfo.dart';
+import 'pool.dart';
+import 'scene.dart';
+
+/// A single file conversion for a [BatchConverter].
+class ConversionJob {
+  /// Converts [input] to [output], importing with the given post-processing
+  /// [flags] and [properties]. See [Scene.fromFile].
+  const ConversionJob(this.input, this.output,
+      {this.flags = 0, this.properties});
+
+  /// The path of the file to import.
+  final String input;
+
+  /// The path of the file to export.
+  final String output;
+
+  /// The post-processing flags applied on import.
+  final int flags;
+
+  /// The import properties.
+  final Map<String, dynamic>? properties;
+}
+
+/// The outcome of a [ConversionJob].
+class ConversionResult {
+  ConversionResult._(this.job, List<Object?> values)
+      : error = values[0] as String?,
+        importTime = Duration(microseconds: values[1] as int),
+        exportTime = Duration(microseconds: values[2] as int),
+        inputSize = values[3] as int,
+        outputSize = values[4] as int,
+        sceneSize = values[5] as int;
+
+  ConversionResult._failed(this.job, this.error)
+      : importTime = Duration.zero,
+        exportTime = Duration.zero,
+        inputSize = 0,
+        outputSize = 0,
+        sceneSize = 0;
+
+  /// The job this is the result of.
+  final ConversionJob job;
+
+  /// The error, such as [Assimp.errorString], or `null` on success.
+  ///
+  /// Import errors are best-effort under concurrency, see
+  /// [ImportException.message].
+  final String? error;
+
+  /// Whether the conversion succeeded.
+  bool get succeeded => error == null;
+
+  /// The time spent importing and post-processing.
+  final Duration importTime;
+
+  /// The time spent exporting.
+  final Duration exportTime;
+
+  /// The size of the input file, in bytes.
+  final int inputSize;
+
+  /// The size of the output file, in bytes.
+  final int outputSize;
+
+  /// The memory used by the imported scene, see [MemoryInfo.total].
+  final int sceneSize;
+
+  @override
+  String toString() => succeeded
+      ? 'ConversionResult(${job.input}: ${importTime.inMilliseconds} + '
+          '${exportTime.inMilliseconds} ms, $inputSize -> $outputSize bytes)'
+      : 'ConversionResult(${job.input}: $error)';
+}
+
+/// Converts files between formats on a pool of worker isolates.
+///
+/// Jobs are pulled from the input lazily and at most [maxPending] of them
+/// are submitted to the pool at a time, so arbitrarily long job lists can
+/// be converted with bounded memory. The result stream also applies
+/// back-pressure: no new jobs are started while it is paused.
+///
+/// Conversions fail while a [LogStream] is attached, see [ImportPool].
+class BatchConverter {
+  /// Creates a converter that exports to the given [format] id (see
+  /// [ExportFormat.id]) with the given export [flags].
+  ///
+  /// Conversions run on [pool], or on a pool of [concurrency] workers owned
+  /// by the converter; pass at most one of them. A job fails without
+  /// exporting if its imported scene uses more than [memoryLimit] bytes.
+  ///
+  /// At most [maxPending] jobs are submitted at a time, twice the pool size
+  /// by default.
+  BatchConverter(
+      {required String format,
+      int flags = 0,
+      int? concurrency,
+      int? maxPending,
+      int? memoryLimit,
+      ImportPool? pool})
+      : this._(format, flags, maxPending, memoryLimit,
+            pool ?? ImportPool(size: concurrency), pool == null),
+        assert(pool == null || concurrency == null);
+
+  BatchConverter._(this.format, this.flags, int? maxPending, this.memoryLimit,
+      this._pool, this._ownsPool)
+      : maxPending = maxPending ?? 2 * _pool.size {
+    assert(this.maxPending > 0);
+  }
+
+  /// The export format id.
+  final String format;
+
+  /// The export pre-processing flags.
+  final int flags;
+
+  /// The maximum number of jobs submitted to the pool at a time.
+  final int maxPending;
+
+  /// The maximum memory of an imported scene, in bytes.
+  final int? memoryLimit;
+
+  final ImportPool _pool;
+  final bool _ownsPool;
+
+  /// Converts all [jobs], emitting a result per job in completion order.
+  ///
+  /// Failed conversions are reported as results with an [error] rather
+  /// than as stream errors.
+  Stream<ConversionResult> convert(Iterable<ConversionJob> jobs) {
+    final iterator = jobs.iterator;
+    final running = HashSet<Future<void>>();
+    late StreamController<ConversionResult> controller;
+    var exhausted = false;
+
+    void pump() {
+      while (!exhausted &&
+          !controller.isPaused &&
+          running.length < maxPending) {
+        if (!iterator.moveNext()) {
+          exhausted = true;
+          break;
+        }
+        final job = iterator.current;
+        late Future<void> future;
+        future = _convert(job).then((result) {
+          running.remove(future);
+          if (!controller.isClosed) controller.add(result);
+          pump();
+        });
+        running.add(future);
+      }
+      if (exhausted && running.isEmpty && !controller.isClosed) {
+        controller.close();
+      }
+    }
+
+    controller = StreamController<ConversionResult>(
+      onListen: pump,
+      onResume: pump,
+      onCancel: () => exhausted = true,
+    );
+    return controller.stream;
+  }
+
+  /// Shuts down the worker pool, if owned by this converter.
+  void close() {
+    if (_ownsPool) _pool.close();
+  }
+
+  // Failed and cancelled conversions complete with an error result.
+  Future<ConversionResult> _convert(ConversionJob job) {
+    final args = [
+      job.input,
+      job.output,
+      format,
+      job.flags,
+      job.properties,
+      flags,
+      memoryLimit
+    ];
+    return _pool.run(_convertTask, args).then(
+        (values) => ConversionResult._(job, values as List<Object?>),
+        onError: (Object error) =>
+            ConversionResult._failed(job, error.toString()));
+  }
+
+  // The global error string of Assimp is shared by all workers, so it may
+  // still be empty or stale.
+  static String _importError(String input) {
+    final error = Assimp.errorString;
+    return error.isEmpty ? 'Failed to import $input' : error;
+  }
+
+  static List<Object?> _convertTask(List<Object?> args) {
+    final input = args[0] as String;
+    final output = args[1] as String;
+    final format = args[2] as String;
+    final memoryLimit = args[6] as int?;
+    final inputFile = File(input);
+    final inputSize = inputFile.existsSync() ? inputFile.lengthSync() : 0;
+    final watch = Stopwatch()..start();
+    final scene = Scene.fromFile(input,
+        flags: args[3] as int, properties: args[4] as Map<String, dynamic>?);
+    final importTime = watch.elapsedMicroseconds;
+    if (scene == null) {
+      return [
+        [_importError(input), importTime, 0, inputSize, 0, 0],
+        null
+      ];
+    }
+    final info = MemoryInfo.fromScene(scene);
+    final sceneSize = info.total;
+    info.dispose();
+    String? error;
+    var exportTime = 0;
+    var outputSize = 0;
+    if (memoryLimit != null && sceneSize > memoryLimit) {
+      error = 'Scene size $sceneSize exceeds memory limit $memoryLimit';
+    } else {
+      watch.reset();
+      final exported =
+          scene.exportFile(output, format: format, flags: args[5] as int);
+      exportTime = watch.elapsedMicroseconds;
+      if (exported) {
+        outputSize = File(output).lengthSync();
+      } else {
+        error = 'Export to $format failed';
+      }
+    }
+    scene.dispose();
+    return [
+      [error, importTime, exportTime, inputSize, outputSize, sceneSize],
+      null
+    ];
+  }
+}
@@ -0,0 +1,720 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'mesh.dart';
+import 'scene.dart';
+
+/// A bounding volume hierarchy over axis-aligned boxes.
+///
+/// Built top-down with a binned surface area heuristic, which takes
+/// O(n log n) time in the number of primitives. Nodes are stored in flat
+/// arrays: the bounds of node `i` are `nodeBounds[i * 6]` up to
+/// `nodeBounds[i * 6 + 6]` (min xyz, max xyz), and `nodeData[i * 2]` and
+/// `nodeData[i * 2 + 1]` are the first primitive and primitive count of a
+/// leaf, or the index of the left child and zero for an inner node. The
+/// right child always follows the left child.
+class Bvh {
+  Bvh._(this.nodeBounds, this.nodeData, this.primitives);
+
+  /// Builds a hierarchy over [bounds], which holds six floats (min xyz, max
+  /// xyz) per primitive.
+  ///
+  /// Leaves hold at most [maxLeafSize] primitives unless the primitives
+  /// cannot be separated. Split candidates are evaluated at [bins] evenly
+  /// spaced planes per axis.
+  factory Bvh.build(Float32List bounds,
+      {int maxLeafSize = 4, int bins = 16}) {
+    final count = bounds.length ~/ 6;
+    final primitives = Uint32List(count);
+    final centroids = Float32List(count * 3);
+    for (var i = 0; i < count; ++i) {
+      primitives[i] = i;
+      for (var k = 0; k < 3; ++k) {
+        centroids[i * 3 + k] = (bounds[i * 6 + k] + bounds[i * 6 + 3 + k]) / 2;
+      }
+    }
+
+    final capacity = math.max(1, 2 * count - 1);
+    final nodeBounds = Float32List(capacity * 6);
+    final nodeData = Int32List(capacity * 2);
+    var nodeCount = 1;
+
+    final binBounds = Float64List(bins * 6);
+    final binCounts = Int32List(bins);
+    final rightAreas = Float64List(bins);
+    final box = Float64List(6);
+    final stack = <int>[0, 0, count];
+    while (stack.isNotEmpty) {
+      final end = stack.removeLast();
+      final start = stack.removeLast();
+      final node = stack.removeLast();
+
+      _empty(box);
+      var cmin0 = double.infinity, cmin1 = double.infinity;
+      var cmin2 = double.infinity;
+      var cmax0 = -double.infinity, cmax1 = -double.infinity;
+      var cmax2 = -double.infinity;
+      for (var i = start; i < end; ++i) {
+        final p = primitives[i];
+        _grow(box, bounds, p * 6);
+        final c0 = centroids[p * 3], c1 = centroids[p * 3 + 1];
+        final c2 = centroids[p * 3 + 2];
+        cmin0 = math.min(cmin0, c0);
+        cmin1 = math.min(cmin1, c1);
+        cmin2 = math.min(cmin2, c2);
+        cmax0 = math.max(cmax0, c0);
+        cmax1 = math.max(cmax1, c1);
+        cmax2 = math.max(cmax2, c2);
+      }
+      for (var k = 0; k < 6; ++k) {
+        nodeBounds[node * 6 + k] = count == 0 ? 0 : box[k];
+      }
+
+      final n = end - start;
+      var bestAxis = -1, bestSplit = 0;
+      var bestCost = double.infinity;
+      if (n > maxLeafSize) {
+        for (var axis = 0; axis < 3; ++axis) {
+          final cmin = axis == 0 ? cmin0 : axis == 1 ? cmin1 : cmin2;
+          final cmax = axis == 0 ? cmax0 : axis == 1 ? cmax1 : cmax2;
+          if (cmax <= cmin) continue;
+          final scale = bins / (cmax - cmin);
+          binCounts.fillRange(0, bins, 0);
+          for (var b = 0; b < bins; ++b) {
+            _empty(binBounds, b * 6);
+          }
+          for (var i = start; i < end; ++i) {
+            final p = primitives[i];
+            final b = math.min(
+                bins - 1, ((centroids[p * 3 + axis] - cmin) * scale).toInt());
+            ++binCounts[b];
+            _grow(binBounds, bounds, p * 6, b * 6);
+          }
+          // sweep from the right to get the areas of all right partitions
+          _empty(box);
+          var rightCount = 0;
+          for (var b = bins - 1; b > 0; --b) {
+            _merge(box, binBounds, b * 6);
+            rightCount += binCounts[b];
+            rightAreas[b] = rightCount == 0 ? 0 : _area(box) * rightCount;
+          }
+          _empty(box);
+          var leftCount = 0;
+          for (var b = 0; b < bins - 1; ++b) {
+            _merge(box, binBounds, b * 6);
+            leftCount += binCounts[b];
+            if (leftCount == 0 || leftCount == n) continue;
+            final cost = _area(box) * leftCount + rightAreas[b + 1];
+            if (cost < bestCost) {
+              bestCost = cost;
+              bestAxis = axis;
+              bestSplit = b + 1;
+            }
+          }
+        }
+      }
+
+      var mid = start;
+      if (bestAxis >= 0) {
+        final parentArea = _area(nodeBounds, node * 6);
+        // stop splitting when a leaf is cheaper than traversal plus children
+        if (parentArea > 0 && bestCost / parentArea + 1 >= n && n <= 16) {
+          bestAxis = -1;
+        }
+      }
+      if (bestAxis >= 0) {
+        final cmin = bestAxis == 0 ? cmin0 : bestAxis == 1 ? cmin1 : cmin2;
+        final cmax = bestAxis == 0 ? cmax0 : bestAxis == 1 ? cmax1 : cmax2;
+        final scale = bins / (cmax - cmin);
+        var j = end - 1;
+        while (mid <= j) {
+          final p = primitives[mid];
+          final b = math.min(bins - 1,
+              ((centroids[p * 3 + bestAxis] - cmin) * scale).toInt());
+          if (b < bestSplit) {
+            ++mid;
+          } else {
+            primitives[mid] = primitives[j];
+            primitives[j--] = p;
+          }
+        }
+      }
+      if (mid == start || mid == end) {
+        nodeData[node * 2] = start;
+        nodeData[node * 2 + 1] = n;
+        continue;
+      }
+
+      final left = nodeCount;
+      nodeCount += 2;
+      nodeData[node * 2] = left;
+      nodeData[node * 2 + 1] = 0;
+      stack.addAll([left + 1, mid, end]);
+      stack.addAll([left, start, mid]);
+    }
+
+    return Bvh._(nodeBounds.sublist(0, nodeCount * 6),
+        nodeData.sublist(0, nodeCount * 2), primitives);
+  }
+
+  /// The bounds of each node, see [Bvh].
+  final Float32List nodeBounds;
+
+  /// The children or primitives of each node, see [Bvh].
+  final Int32List nodeData;
+
+  /// The primitive indices, ordered so that each leaf refers to a range.
+  final Uint32List primitives;
+
+  /// The number of nodes.
+  int get nodeCount => nodeData.length ~/ 2;
+
+  /// The bounds of all primitives.
+  Aabb3 get bounds => Aabb3.minMax(
+      Vector3(nodeBounds[0], nodeBounds[1], nodeBounds[2]),
+      Vector3(nodeBounds[3], nodeBounds[4], nodeBounds[5]));
+
+  /// Calls [visit] for each primitive whose leaf overlaps [box].
+  ///
+  /// Only the leaf bounds are tested; test the primitive bounds to filter
+  /// the candidates if needed.
+  void queryAabb(Aabb3 box, void Function(int primitive) visit) {
+    if (primitives.isEmpty) return;
+    final min = box.min, max = box.max;
+    final stack = <int>[0];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final o = node * 6;
+      if (nodeBounds[o] > max.x ||
+          nodeBounds[o + 1] > max.y ||
+          nodeBounds[o + 2] > max.z ||
+          nodeBounds[o + 3] < min.x ||
+          nodeBounds[o + 4] < min.y ||
+          nodeBounds[o + 5] < min.z) {
+        continue;
+      }
+      _visitOrPush(node, stack, visit);
+    }
+  }
+
+  /// Calls [visit] for each primitive whose leaf intersects [frustum].
+  void queryFrustum(Frustum frustum, void Function(int primitive) visit) {
+    if (primitives.isEmpty) return;
+    final planes = Float64List(24);
+    final list = [
+      frustum.plane0,
+      frustum.plane1,
+      frustum.plane2,
+      frustum.plane3,
+      frustum.plane4,
+      frustum.plane5
+    ];
+    for (var i = 0; i < 6; ++i) {
+      planes[i * 4] = list[i].normal.x;
+      planes[i * 4 + 1] = list[i].normal.y;
+      planes[i * 4 + 2] = list[i].normal.z;
+      planes[i * 4 + 3] = list[i].constant;
+    }
+    final stack = <int>[0];
+    outer:
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final o = node * 6;
+      for (var i = 0; i < 24; i += 4) {
+        // the box corner furthest along the plane normal
+        final nx = planes[i], ny = planes[i + 1], nz = planes[i + 2];
+        final x = nx >= 0 ? nodeBounds[o + 3] : nodeBounds[o];
+        final y = ny >= 0 ? nodeBounds[o + 4] : nodeBounds[o + 1];
+        final z = nz >= 0 ? nodeBounds[o + 5] : nodeBounds[o + 2];
+        if (nx * x + ny * y + nz * z + planes[i + 3] < 0) continue outer;
+      }
+      _visitOrPush(node, stack, visit);
+    }
+  }
+
+  /// Calls [hit] for each primitive whose leaf is hit by the ray from
+  /// ([ox], [oy], [oz]) in direction ([dx], [dy], [dz]) within [maxDistance]
+  /// (in units of the direction length), nearest leaves first.
+  ///
+  /// [hit] returns the distance of its intersection with the primitive, or
+  /// a negative value if none. Leaves beyond the nearest intersection found
+  /// so far are skipped. Returns the nearest distance, or a negative value
+  /// if nothing was hit.
+  double queryRay(double ox, double oy, double oz, double dx, double dy,
+      double dz, double maxDistance, double Function(int primitive) hit) {
+    if (primitives.isEmpty) return -1;
+    final ix = 1 / dx, iy = 1 / dy, iz = 1 / dz;
+    final root = raySlab(nodeBounds, 0, ox, oy, oz, ix, iy, iz, maxDistance);
+    if (root < 0) return -1;
+    var nearest = maxDistance;
+    var found = false;
+    final stack = <int>[0];
+    final entries = <double>[root];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final entry = entries.removeLast();
+      if (entry > nearest) continue;
+      final first = nodeData[node * 2];
+      final count = nodeData[node * 2 + 1];
+      if (count > 0) {
+        for (var i = first; i < first + count; ++i) {
+          final t = hit(primitives[i]);
+          if (t >= 0 && t <= nearest) {
+            nearest = t;
+            found = true;
+          }
+        }
+        continue;
+      }
+      final tl =
+          raySlab(nodeBounds, first * 6, ox, oy, oz, ix, iy, iz, nearest);
+      final tr =
+          raySlab(nodeBounds, first * 6 + 6, ox, oy, oz, ix, iy, iz, nearest);
+      // push the farther child first so that the nearer one is visited first
+      final leftFirst = tr < 0 || (tl >= 0 && tl <= tr);
+      final near = leftFirst ? first : first + 1;
+      final far = leftFirst ? first + 1 : first;
+      final tNear = leftFirst ? tl : tr;
+      final tFar = leftFirst ? tr : tl;
+      if (tFar >= 0) {
+        stack.add(far);
+        entries.add(tFar);
+      }
+      if (tNear >= 0) {
+        stack.add(near);
+        entries.add(tNear);
+      }
+    }
+    return found ? nearest : -1;
+  }
+
+  /// Returns the distance at which a ray enters the box at [offset] in
+  /// [bounds], or -1 if it misses the box within [maxDistance].
+  ///
+  /// The ray starts at ([ox], [oy], [oz]), and [ix], [iy] and [iz] are the
+  /// reciprocals of its direction.
+  static double raySlab(Float32List bounds, int offset, double ox, double oy,
+      double oz, double ix, double iy, double iz, double maxDistance) {
+    final o = offset;
+    var near = double.negativeInfinity, far = double.infinity;
+    // A zero direction component makes its reciprocal infinite, and an
+    // origin on a plane of that slab gives 0 * inf = NaN. The ray then runs
+    // within the slab, so the slab does not clip it.
+    var t0 = (bounds[o] - ox) * ix, t1 = (bounds[o + 3] - ox) * ix;
+    if (!t0.isNaN && !t1.isNaN) {
+      near = math.min(t0, t1);
+      far = math.max(t0, t1);
+    }
+    t0 = (bounds[o + 1] - oy) * iy;
+    t1 = (bounds[o + 4] - oy) * iy;
+    if (!t0.isNaN && !t1.isNaN) {
+      near = math.max(near, math.min(t0, t1));
+      far = math.min(far, math.max(t0, t1));
+    }
+    t0 = (bounds[o + 2] - oz) * iz;
+    t1 = (bounds[o + 5] - oz) * iz;
+    if (!t0.isNaN && !t1.isNaN) {
+      near = math.max(near, math.min(t0, t1));
+      far = math.min(far, math.max(t0, t1));
+    }
+    if (far < math.max(near, 0) || near > maxDistance) return -1;
+    return math.max(near, 0);
+  }
+
+  void _visitOrPush(int node, List<int> stack, void Function(int) visit) {
+    final first = nodeData[node * 2];
+    final count = nodeData[node * 2 + 1];
+    if (count == 0) {
+      stack.addAll([first, first + 1]);
+      return;
+    }
+    for (var i = first; i < first + count; ++i) {
+      visit(primitives[i]);
+    }
+  }
+
+  static void _empty(List<double> box, [int o = 0]) {
+    box[o] = box[o + 1] = box[o + 2] = double.infinity;
+    box[o + 3] = box[o + 4] = box[o + 5] = -double.infinity;
+  }
+
+  static void _grow(List<double> box, Float32List bounds, int i, [int o = 0]) {
+    for (var k = 0; k < 3; ++k) {
+      box[o + k] = math.min(box[o + k], bounds[i + k]);
+      box[o + 3 + k] = math.max(box[o + 3 + k], bounds[i + 3 + k]);
+    }
+  }
+
+  static void _merge(List<double> box, List<double> other, int i) {
+    for (var k = 0; k < 3; ++k) {
+      box[k] = math.min(box[k], other[i + k]);
+      box[3 + k] = math.max(box[3 + k], other[i + 3 + k]);
+    }
+  }
+
+  static double _area(List<double> box, [int o = 0]) {
+    final x = box[o + 3] - box[o];
+    final y = box[o + 4] - box[o + 1];
+    final z = box[o + 5] - box[o + 2];
+    if (x < 0 || y < 0 || z < 0) return 0;
+    return x * y + y * z + z * x;
+  }
+}
+
+/// A ray intersection found by [MeshBvh] or [SceneBvh].
+class RayHit {
+  const RayHit(this.distance, this.triangle, this.u, this.v,
+      [this.instance = -1]);
+
+  /// The distance along the ray, in units of the ray direction length.
+  final double distance;
+
+  /// The index of the hit triangle, or -1 for a bounding box hit.
+  final int triangle;
+
+  /// The barycentric coordinates of the hit point; the weights of the
+  /// triangle vertices are `1 - u - v`, [u] and [v].
+  final double u, v;
+
+  /// The [SceneBvh] instance that was hit, or -1 for a [MeshBvh] hit.
+  final int instance;
+
+  @override
+  String toString() => 'RayHit($distance, triangle: $triangle, '
+      'instance: $instance)';
+}
+
+/// A triangle [Bvh] over a mesh.
+class MeshBvh {
+  MeshBvh._(this.positions, this.indices, this.bvh);
+
+  /// Builds a hierarchy over the triangles given by [indices], three per
+  /// triangle, into the xyz [positions].
+  factory MeshBvh(Float32List positions, Uint32List indices,
+      {int maxLeafSize = 4}) {
+    final count = indices.length ~/ 3;
+    final bounds = Float32List(count * 6);
+    for (var t = 0; t < count; ++t) {
+      for (var k = 0; k < 3; ++k) {
+        final a = positions[indices[t * 3] * 3 + k];
+        final b = positions[indices[t * 3 + 1] * 3 + k];
+        final c = positions[indices[t * 3 + 2] * 3 + k];
+        bounds[t * 6 + k] = math.min(a, math.min(b, c));
+        bounds[t * 6 + 3 + k] = math.max(a, math.max(b, c));
+      }
+    }
+    return MeshBvh._(positions, indices,
+        Bvh.build(bounds, maxLeafSize: maxLeafSize));
+  }
+
+  /// Builds a hierarchy over the triangles of [mesh].
+  ///
+  /// Point and line faces are skipped. Throws an [ArgumentError] if the
+  /// mesh has polygons, see [Mesh.triangleIndexData]. The vertex data is
+  /// copied, so the hierarchy stays valid after the scene is released.
+  factory MeshBvh.fromMesh(Mesh mesh, {int maxLeafSize = 4}) {
+    return MeshBvh(
+        Float32List.fromList(mesh.vertexData), mesh.triangleIndexData,
+        maxLeafSize: maxLeafSize);
+  }
+
+  /// The vertex positions, three floats per vertex.
+  final Float32List positions;
+
+  /// The triangle indices, three per triangle.
+  final Uint32List indices;
+
+  /// The hierarchy over the triangle bounds.
+  final Bvh bvh;
+
+  /// Returns the nearest triangle hit by [ray] within [maxDistance], or
+  /// `null` if none.
+  RayHit? raycast(Ray ray, {double maxDistance = double.infinity}) {
+    final o = ray.origin, d = ray.direction;
+    return raycastXyz(o.x, o.y, o.z, d.x, d.y, d.z, maxDistance);
+  }
+
+  /// Same as [raycast], but takes the ray as components to avoid
+  /// temporary vectors.
+  RayHit? raycastXyz(double ox, double oy, double oz, double dx, double dy,
+      double dz, double maxDistance) {
+    var triangle = -1;
+    var best = double.infinity, hitU = 0.0, hitV = 0.0;
+    bvh.queryRay(ox, oy, oz, dx, dy, dz, maxDistance, (i) {
+      // Möller-Trumbore
+      final a = indices[i * 3] * 3;
+      final b = indices[i * 3 + 1] * 3;
+      final c = indices[i * 3 + 2] * 3;
+      final ax = positions[a], ay = positions[a + 1], az = positions[a + 2];
+      final e1x = positions[b] - ax, e1y = positions[b + 1] - ay;
+      final e1z = positions[b + 2] - az;
+      final e2x = positions[c] - ax, e2y = positions[c + 1] - ay;
+      final e2z = positions[c + 2] - az;
+      final px = dy * e2z - dz * e2y;
+      final py = dz * e2x - dx * e2z;
+      final pz = dx * e2y - dy * e2x;
+      final det = e1x * px + e1y * py + e1z * pz;
+      if (det.abs() < 1e-12) return -1;
+      final inv = 1 / det;
+      final sx = ox - ax, sy = oy - ay, sz = oz - az;
+      final u = (sx * px + sy * py + sz * pz) * inv;
+      if (u < 0 || u > 1) return -1;
+      final qx = sy * e1z - sz * e1y;
+      final qy = sz * e1x - sx * e1z;
+      final qz = sx * e1y - sy * e1x;
+      final v = (dx * qx + dy * qy + dz * qz) * inv;
+      if (v < 0 || u + v > 1) return -1;
+      final t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+      if (t < 0 || t > maxDistance) return -1;
+      if (t < best) {
+        best = t;
+        triangle = i;
+        hitU = u;
+        hitV = v;
+      }
+      return t;
+    });
+    if (triangle < 0) return null;
+    return RayHit(best, triangle, hitU, hitV);
+  }
+}
+
+/// A spatial index over the mesh instances of a scene.
+///
+/// Every mesh reference of every node is an instance, with a world space
+/// bounding box computed from the mesh bounds (see
+/// [ProcessFlags.generateBoundingBoxes], or from the vertices if absent)
+/// and the world transformation of the node. Instances are indexed by a
+/// [Bvh] for ray casts, frustum culling and box overlap queries. With
+/// per-mesh triangle hierarchies, ray casts return the exact triangle.
+///
+/// The index is a copy; it does not follow changes to the scene.
+class SceneBvh {
+  SceneBvh._(this.instanceNodes, this.instanceMeshes, this.instanceBounds,
+      this.bvh, this.meshes, this._inverses);
+
+  /// Builds the index for [scene].
+  ///
+  /// If [triangles] is true, a [MeshBvh] is also built for each mesh; the
+  /// meshes must then be triangulated.
+  factory SceneBvh.fromScene(Scene scene, {bool triangles = false}) {
+    final hierarchy = scene.flattenHierarchy();
+    final meshList = scene.meshes.toList();
+    final meshBounds = Float32List(meshList.length * 6);
+    for (var m = 0; m < meshList.length; ++m) {
+      _meshBounds(meshList[m], meshBounds, m * 6);
+    }
+
+    final count = hierarchy.meshIndices.length;
+    final instanceNodes = Int32List(count);
+    final instanceMeshes = Int32List(count);
+    final instanceBounds = Float32List(count * 6);
+    final worlds = hierarchy.worlds;
+    for (var node = 0, i = 0; node < hierarchy.length; ++node) {
+      for (var k = hierarchy.meshOffsets[node];
+          k < hierarchy.meshOffsets[node + 1];
+          ++k, ++i) {
+        final mesh = hierarchy.meshIndices[k];
+        instanceNodes[i] = node;
+        instanceMeshes[i] = mesh;
+        _transformBounds(
+            meshBounds, mesh * 6, worlds, node * 16, instanceBounds, i * 6);
+      }
+    }
+
+    List<MeshBvh>? meshes;
+    Float32List? inverses;
+    if (triangles) {
+      meshes = [for (final mesh in meshList) MeshBvh.fromMesh(mesh)];
+      inverses = Float32List(count * 16);
+      final inverse = Matrix4.zero();
+      for (var i = 0; i < count; ++i) {
+        inverse.copyInverse(hierarchy.world(instanceNodes[i]));
+        inverses.setAll(i * 16, inverse.storage);
+      }
+    }
+    return SceneBvh._(instanceNodes, instanceMeshes, instanceBounds,
+        Bvh.build(instanceBounds), meshes, inverses);
+  }
+
+  /// The node of each instance, as an index into [Scene.flattenHierarchy].
+  final Int32List instanceNodes;
+
+  /// The mesh of each instance, as an index into [Scene.meshes].
+  final Int32List instanceMeshes;
+
+  /// The world space bounds of each instance, min xyz and max xyz.
+  final Float32List instanceBounds;
+
+  /// The hierarchy over [instanceBounds].
+  final Bvh bvh;
+
+  /// The triangle hierarchy of each mesh, if built.
+  final List<MeshBvh>? meshes;
+
+  final Float32List? _inverses;
+
+  /// The number of instances.
+  int get length => instanceNodes.length;
+
+  /// The world space bounds of the scene.
+  Aabb3 get bounds => bvh.bounds;
+
+  /// Returns the world space bounds of [instance].
+  Aabb3 instanceBoundsOf(int instance) {
+    final b = instanceBounds, o = instance * 6;
+    return Aabb3.minMax(Vector3(b[o], b[o + 1], b[o + 2]),
+        Vector3(b[o + 3], b[o + 4], b[o + 5]));
+  }
+
+  /// Returns the instances whose bounds intersect [frustum].
+  List<int> cull(Frustum frustum) {
+    final result = <int>[];
+    bvh.queryFrustum(frustum, result.add);
+    return result;
+  }
+
+  /// Returns the instances whose bounds overlap [box].
+  List<int> overlaps(Aabb3 box) {
+    final result = <int>[];
+    final min = box.min, max = box.max;
+    bvh.queryAabb(box, (i) {
+      final o = i * 6;
+      if (instanceBounds[o] <= max.x &&
+          instanceBounds[o + 1] <= max.y &&
+          instanceBounds[o + 2] <= max.z &&
+          instanceBounds[o + 3] >= min.x &&
+          instanceBounds[o + 4] >= min.y &&
+          instanceBounds[o + 5] >= min.z) {
+        result.add(i);
+      }
+    });
+    return result;
+  }
+
+  /// Returns the nearest hit of [ray] within [maxDistance], or `null` if
+  /// none.
+  ///
+  /// With triangle hierarchies, the ray is tested against the triangles of
+  /// each candidate instance in its local space. Otherwise the nearest
+  /// instance bounding box is returned, with [RayHit.triangle] set to -1.
+  RayHit? raycast(Ray ray, {double maxDistance = double.infinity}) {
+    final o = ray.origin, d = ray.direction;
+    RayHit? nearest;
+    final inverses = _inverses;
+    bvh.queryRay(o.x, o.y, o.z, d.x, d.y, d.z, maxDistance, (i) {
+      final limit = nearest?.distance ?? maxDistance;
+      if (inverses == null) {
+        final t = Bvh.raySlab(instanceBounds, i * 6, o.x, o.y, o.z, 1 / d.x,
+            1 / d.y, 1 / d.z, limit);
+        if (t >= 0 && t < limit) nearest = RayHit(t, -1, 0, 0, i);
+        return t;
+      }
+      // the local ray keeps the parametrization of the world ray
+      final m = i * 16;
+      final lox = inverses[m] * o.x + inverses[m + 4] * o.y +
+          inverses[m + 8] * o.z + inverses[m + 12];
+      final loy = inverses[m + 1] * o.x + inverses[m + 5] * o.y +
+          inverses[m + 9] * o.z + inverses[m + 13];
+      final loz = inverses[m + 2] * o.x + inverses[m + 6] * o.y +
+          inverses[m + 10] * o.z + inverses[m + 14];
+      final ldx = inverses[m] * d.x + inverses[m + 4] * d.y +
+          inverses[m + 8] * d.z;
+      final ldy = inverses[m + 1] * d.x + inverses[m + 5] * d.y +
+          inverses[m + 9] * d.z;
+      final ldz = inverses[m + 2] * d.x + inverses[m + 6] * d.y +
+          inverses[m + 10] * d.z;
+      final hit = meshes![instanceMeshes[i]]
+          .raycastXyz(lox, loy, loz, ldx, ldy, ldz, limit);
+      if (hit == null || hit.distance >= limit) return -1;
+      nearest = RayHit(hit.distance, hit.triangle, hit.u, hit.v, i);
+      return hit.distance;
+    });
+    return nearest;
+  }
+
+  static void _meshBounds(Mesh mesh, Float32List out, int o) {
+    final aabb = mesh.ptr.ref.mAABB;
+    final min = aabb.mMin, max = aabb.mMax;
+    if (min.x < max.x || min.y < max.y || min.z < max.z) {
+      out[o] = min.x;
+      out[o + 1] = min.y;
+      out[o + 2] = min.z;
+      out[o + 3] = max.x;
+      out[o + 4] = max.y;
+      out[o + 5] = max.z;
+      return;
+    }
+    final vertices = mesh.vertexData;
+    if (vertices.isEmpty) return;
+    Bvh._empty(out, o);
+    for (var i = 0; i < vertices.length; i += 3) {
+      for (var k = 0; k < 3; ++k) {
+        out[o + k] = math.min(out[o + k], vertices[i + k]);
+        out[o + 3 + k] = math.max(out[o + 3 + k], vertices[i + k]);
+      }
+    }
+  }
+
+  // Transforms the box at [b] by the column-major matrix at [m] and stores
+  // the bounds of the result at [o].
+  static void _transformBounds(Float32List boxes, int b, Float32List matrices,
+      int m, Float32List out, int o) {
+    for (var r = 0; r < 3; ++r) {
+      var lo = matrices[m + 12 + r], hi = lo;
+      for (var c = 0; c < 3; ++c) {
+        final a = matrices[m + c * 4 + r] * boxes[b + c];
+        final z = matrices[m + c * 4 + r] * boxes[b + 3 + c];
+        lo += math.min(a, z);
+        hi += math.max(a, z);
+      }
+      out[o + r] = lo;
+      out[o + 3 + r] = hi;
+    }
+  }
+}
@@ -0,0 +1,284 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:collection';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'filesystem.dart';
+import 'hash.dart' as fnv;
+import 'meminfo.dart';
+import 'scene.dart';
+
+/// A reference to a scene owned by a [SceneCache].
+///
+/// Call [release] when done with the scene instead of [Scene.dispose]; the
+/// cache disposes the scene once it is no longer referenced and has been
+/// evicted.
+class SceneHandle {
+  SceneHandle._(this._entry);
+
+  final _CacheEntry _entry;
+  bool _released = false;
+
+  /// The cached scene.
+  Scene get scene {
+    if (_released) throw StateError('SceneHandle has been released');
+    return _entry.scene;
+  }
+
+  /// Releases this reference to the scene.
+  void release() {
+    if (_released) return;
+    _released = true;
+    _entry.cache._release(_entry);
+  }
+}
+
+class _CacheEntry {
+  final SceneCache cache;
+  final String key;
+  final Scene scene;
+  final int size;
+  final List<_FileStamp> dependencies;
+  int references = 0;
+  bool evicted = false;
+
+  _CacheEntry(
+      this.cache, this.key, this.scene, this.size, this.dependencies);
+}
+
+class _FileHash {
+  final DateTime modified;
+  final int length;
+  final int hash;
+
+  _FileHash(this.modified, this.length, this.hash);
+}
+
+class _FileStamp {
+  final String path;
+  final DateTime modified;
+  final int length;
+
+  _FileStamp(this.path, FileStat stat)
+      : modified = stat.modified,
+        length = stat.size;
+
+  bool get isCurrent {
+    final stat = File(path).statSync();
+    return stat.type != FileSystemEntityType.notFound &&
+        stat.modified == modified &&
+        stat.size == length;
+  }
+}
+
+// Records the files that Assimp opens during an import.
+class _RecordingFileSystem extends DirectoryFileSystem {
+  final paths = <String>{};
+
+  @override
+  FileHandle? open(String path, String mode) {
+    final file = super.open(path, mode);
+    if (file != null) paths.add(path);
+    return file;
+  }
+}
+
+/// Caches imported scenes by file content, post-processing flags and import
+/// properties.
+///
+/// Importing the same file with the same flags and properties again returns
+/// the already imported scene. Scenes are reference counted through
+/// [SceneHandle]s. Unreferenced scenes are kept until the total memory of
+/// the cached scenes, as reported by [MemoryInfo.total], exceeds
+/// [maxBytes], at which point the least recently used ones are evicted.
+///
+/// File contents are identified by a 64-bit FNV-1a hash, which is only
+/// recomputed when the size or modification time of a file changes. Other
+/// files read by the import, such as OBJ materials or glTF buffers, are
+/// tracked by size and modification time; a cached scene is imported again
+/// when one of them changes. Files that did not exist at import time are
+/// not tracked.
+class SceneCache {
+  /// Creates a cache that keeps at most [maxBytes] of unreferenced scenes.
+  SceneCache({this.maxBytes = 256 * 1024 * 1024});
+
+  /// The memory budget, in bytes.
+  final int maxBytes;
+
+  // in least to most recently used order
+  final _entries = LinkedHashMap<String, _CacheEntry>();
+  final _hashes = <String, _FileHash>{};
+  int _size = 0;
+  int _hits = 0;
+  int _misses = 0;
+  int _evictions = 0;
+
+  /// The number of loads served from the cache.
+  int get hits => _hits;
+
+  /// The number of loads that imported the file.
+  int get misses => _misses;
+
+  /// The number of scenes evicted to stay within [maxBytes].
+  int get evictions => _evictions;
+
+  /// The number of cached scenes.
+  int get length => _entries.length;
+
+  /// The total memory of the cached scenes, in bytes.
+  int get size => _size;
+
+  /// Returns a handle to the scene imported from [path] with the given
+  /// [flags] and [properties], importing it if it is not cached.
+  ///
+  /// Returns `null` if the file cannot be read or the import fails. See
+  /// [Scene.fromFile].
+  SceneHandle? load(String path,
+      {int flags = 0, Map<String, dynamic>? properties}) {
+    final hash = _hashFile(path);
+    if (hash == null) return null;
+    final key = '${hash.toRadixString(16)}:$flags:'
+        '${canonicalProperties(properties)}';
+    var entry = _entries.remove(key);
+    if (entry != null && !entry.dependencies.every((file) => file.isCurrent)) {
+      _entries[key] = entry;
+      _remove(entry);
+      entry = null;
+    }
+    if (entry != null) {
+      ++_hits;
+      _entries[key] = entry;
+    } else {
+      ++_misses;
+      final fileSystem = _RecordingFileSystem();
+      final scene = Scene.fromFile(path,
+          flags: flags, properties: properties, fileSystem: fileSystem);
+      if (scene == null) return null;
+      final main = FileSystem.normalize(path);
+      final dependencies = [
+        for (final file in fileSystem.paths)
+          if (FileSystem.normalize(file) != main)
+            _FileStamp(file, File(file).statSync())
+      ];
+      final info = MemoryInfo.fromScene(scene);
+      entry = _CacheEntry(this, key, scene, info.total, dependencies);
+      info.dispose();
+      _entries[key] = entry;
+      _size += entry.size;
+    }
+    ++entry.references;
+    _evict();
+    return SceneHandle._(entry);
+  }
+
+  /// Evicts and disposes all unreferenced scenes.
+  void clear() {
+    for (final entry in _entries.values.toList()) {
+      if (entry.references == 0) _remove(entry);
+    }
+  }
+
+  void _release(_CacheEntry entry) {
+    if (--entry.references > 0) return;
+    if (entry.evicted) {
+      entry.scene.dispose();
+    } else {
+      _evict();
+    }
+  }
+
+  void _evict() {
+    if (_size <= maxBytes) return;
+    for (final entry in _entries.values.toList()) {
+      if (_size <= maxBytes) break;
+      if (entry.references > 0) continue;
+      _remove(entry);
+      ++_evictions;
+    }
+  }
+
+  void _remove(_CacheEntry entry) {
+    _entries.remove(entry.key);
+    _size -= entry.size;
+    entry.evicted = true;
+    if (entry.references == 0) entry.scene.dispose();
+  }
+
+  // Returns null if the file cannot be read.
+  int? _hashFile(String path) {
+    final stat = File(path).statSync();
+    final cached = _hashes[path];
+    if (cached != null &&
+        cached.modified == stat.modified &&
+        cached.length == stat.size) {
+      return cached.hash;
+    }
+    try {
+      final value = fnv.fnv1a64(File(path).readAsBytesSync());
+      _hashes[path] = _FileHash(stat.modified, stat.size, value);
+      return value;
+    } on FileSystemException {
+      _hashes.remove(path);
+      return null;
+    }
+  }
+
+  /// Computes the 64-bit FNV-1a hash of [bytes].
+  static int fnv1a64(Uint8List bytes) => fnv.fnv1a64(bytes);
+
+  /// Returns a canonical string for import [properties], independent of
+  /// the order of the entries.
+  static String canonicalProperties(Map<String, dynamic>? properties) {
+    if (properties == null || properties.isEmpty) return '';
+    final keys = properties.keys.toList()..sort();
+    return keys.map((key) {
+      final value = properties[key];
+      if (value is Matrix4) return '$key=m${value.storage.join(',')}';
+      return '$key=${value.runtimeType}:$value';
+    }).join(';');
+  }
+}
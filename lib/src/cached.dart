@@ -0,0 +1,326 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'animation.dart';
+import 'bindings.dart';
+import 'camera.dart';
+import 'light.dart';
+import 'lookup.dart';
+import 'material.dart';
+import 'mesh.dart';
+import 'names.dart';
+import 'node.dart';
+import 'scene.dart';
+import 'texture.dart';
+
+/// A cached view of a [Scene].
+///
+/// The getters of [Scene] and its parts create new wrapper objects and
+/// convert native values on every call, and `elementAt(i)` on their
+/// iterables takes O(i) time. The cached view materializes the wrappers
+/// into lists once, converts names, transformations and vertices once, and
+/// interns the strings, so repeated traversals (for example once per frame)
+/// allocate nothing.
+///
+/// The cache is dropped when the scene is post-processed through this
+/// library, that is by [Scene.postProcess] or [Scene.profilePostProcess],
+/// and rebuilt on the next access. Setting [Node.transformation] on a node
+/// of the scene only drops the cached transformations. Changes made to the
+/// native data by other means are not detected; call [invalidate] after
+/// them.
+class CachedScene {
+  CachedScene(this.scene)
+      : _validTopology = _topologies[scene.ptr.address] ?? 0,
+        _validTransforms = _transforms[scene.ptr.address] ?? 0 {
+    _own(scene.ptr);
+  }
+
+  // Mutation counters keyed by aiScene address.
+  static final _topologies = <int, int>{};
+  static final _transforms = <int, int>{};
+  // The aiScene addresses of cached scenes, keyed by root aiNode address.
+  static final _owners = <int, int>{};
+
+  /// Marks the cached views of [scene] as stale.
+  ///
+  /// @internal
+  static void markTopologyChanged(Pointer<aiScene> scene) {
+    _topologies[scene.address] = (_topologies[scene.address] ?? 0) + 1;
+    // post-processing may have replaced the root node
+    _disown(scene);
+  }
+
+  /// Marks the cached transformations of the scene of [node] as stale.
+  ///
+  /// @internal
+  static void markTransformChanged(Pointer<aiNode> node) {
+    while (node.ref.mParent != nullptr) {
+      node = node.ref.mParent;
+    }
+    final scene = _owners[node.address];
+    if (scene == null) return;
+    _transforms[scene] = (_transforms[scene] ?? 0) + 1;
+  }
+
+  /// Forgets the counters of [scene] when it is released.
+  ///
+  /// @internal
+  static void release(Pointer<aiScene> scene) {
+    _topologies.remove(scene.address);
+    _transforms.remove(scene.address);
+    _disown(scene);
+  }
+
+  static void _own(Pointer<aiScene> scene) {
+    if (scene == nullptr || scene.ref.mRootNode == nullptr) return;
+    _owners[scene.ref.mRootNode.address] = scene.address;
+  }
+
+  static void _disown(Pointer<aiScene> scene) {
+    _owners.removeWhere((root, owner) => owner == scene.address);
+  }
+
+  /// The scene this view caches.
+  final Scene scene;
+
+  int _validTopology;
+  int _validTransforms;
+  final _strings = <String, String>{};
+  List<Mesh>? _meshes;
+  List<Material>? _materials;
+  List<Animation>? _animations;
+  List<Texture>? _textures;
+  List<Light>? _lights;
+  List<Camera>? _cameras;
+  List<Node>? _nodes;
+  List<int>? _parents;
+  List<List<int>>? _children;
+  SceneIndex? _index;
+  final _nodeNames = <int, String>{};
+  final _transformations = <int, Matrix4>{};
+  final _meshNames = <int, String>{};
+  final _vertices = <int, List<Vector3>>{};
+  final _normals = <int, List<Vector3>>{};
+
+  /// Whether the scene was post-processed since the cache was built.
+  bool get isStale =>
+      _validTopology != (_topologies[scene.ptr.address] ?? 0);
+
+  /// Drops all cached values.
+  void invalidate() {
+    _validTopology = _topologies[scene.ptr.address] ?? 0;
+    _validTransforms = _transforms[scene.ptr.address] ?? 0;
+    _own(scene.ptr);
+    _strings.clear();
+    _meshes = null;
+    _materials = null;
+    _animations = null;
+    _textures = null;
+    _lights = null;
+    _cameras = null;
+    _nodes = null;
+    _parents = null;
+    _children = null;
+    _index = null;
+    _nodeNames.clear();
+    _transformations.clear();
+    _meshNames.clear();
+    _vertices.clear();
+    _normals.clear();
+  }
+
+  void _validate() {
+    if (isStale) {
+      invalidate();
+      return;
+    }
+    final transforms = _transforms[scene.ptr.address] ?? 0;
+    if (_validTransforms != transforms) {
+      _validTransforms = transforms;
+      _transformations.clear();
+    }
+  }
+
+  /// Returns the canonical instance of [value].
+  ///
+  /// Equal names returned by this view are identical strings.
+  String intern(String value) {
+    _validate();
+    return _strings.putIfAbsent(value, () => value);
+  }
+
+  /// The meshes of the scene.
+  List<Mesh> get meshes {
+    _validate();
+    return _meshes ??= List.unmodifiable(scene.meshes);
+  }
+
+  /// The materials of the scene.
+  ///
+  /// The materials keep their [Material.index] while the cache is valid.
+  List<Material> get materials {
+    _validate();
+    return _materials ??= List.unmodifiable(scene.materials);
+  }
+
+  /// The animations of the scene.
+  List<Animation> get animations {
+    _validate();
+    return _animations ??= List.unmodifiable(scene.animations);
+  }
+
+  /// The embedded textures of the scene.
+  List<Texture> get textures {
+    _validate();
+    return _textures ??= List.unmodifiable(scene.textures);
+  }
+
+  /// The lights of the scene.
+  List<Light> get lights {
+    _validate();
+    return _lights ??= List.unmodifiable(scene.lights);
+  }
+
+  /// The cameras of the scene.
+  List<Camera> get cameras {
+    _validate();
+    return _cameras ??= List.unmodifiable(scene.cameras);
+  }
+
+  /// All nodes of the scene in depth-first preorder, starting with the
+  /// root node.
+  List<Node> get nodes {
+    _validate();
+    if (_nodes == null) _buildNodes();
+    return _nodes!;
+  }
+
+  /// The index into [nodes] of the parent of the node at [index], or -1
+  /// for the root node.
+  int parentOf(int index) {
+    _validate();
+    if (_nodes == null) _buildNodes();
+    return _parents![index];
+  }
+
+  /// The indices into [nodes] of the children of the node at [index].
+  List<int> childrenOf(int index) {
+    _validate();
+    if (_nodes == null) _buildNodes();
+    return _children![index];
+  }
+
+  /// The ids of the node, bone and channel names of the scene, see
+  /// [NameTable.fromScene].
+  NameTable get names => index.names;
+
+  /// The name-indexed lookups of the scene, see [SceneIndex].
+  SceneIndex get index {
+    _validate();
+    return _index ??= SceneIndex.fromScene(scene);
+  }
+
+  /// The interned name of the node at [index].
+  String nodeName(int index) {
+    final node = nodes[index];
+    return _nodeNames.putIfAbsent(index, () => intern(node.name));
+  }
+
+  /// The transformation of the node at [index] relative to its parent.
+  ///
+  /// The returned matrix is shared; do not modify it. Set
+  /// [Node.transformation] instead.
+  Matrix4 transformation(int index) {
+    final node = nodes[index];
+    return _transformations.putIfAbsent(index, () => node.transformation);
+  }
+
+  /// The interned name of the mesh at [index].
+  String meshName(int index) {
+    final mesh = meshes[index];
+    return _meshNames.putIfAbsent(index, () => intern(mesh.name));
+  }
+
+  /// The vertex positions of the mesh at [index].
+  List<Vector3> vertices(int index) {
+    final mesh = meshes[index];
+    return _vertices.putIfAbsent(
+        index, () => List.unmodifiable(mesh.vertices));
+  }
+
+  /// The vertex normals of the mesh at [index], empty if not present.
+  List<Vector3> normals(int index) {
+    final mesh = meshes[index];
+    return _normals.putIfAbsent(index, () => List.unmodifiable(mesh.normals));
+  }
+
+  void _buildNodes() {
+    final nodes = <Node>[];
+    final parents = <int>[];
+    final children = <List<int>>[];
+    final stack = <Node>[scene.rootNode];
+    final parentStack = <int>[-1];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final parent = parentStack.removeLast();
+      final index = nodes.length;
+      nodes.add(node);
+      parents.add(parent);
+      children.add(<int>[]);
+      if (parent >= 0) children[parent].add(index);
+      final list = node.children.toList();
+      for (var i = list.length - 1; i >= 0; --i) {
+        stack.add(list[i]);
+        parentStack.add(index);
+      }
+    }
+    _nodes = List.unmodifiable(nodes);
+    _parents = List.unmodifiable(parents);
+    _children = List.unmodifiable(
+        children.map((list) => List<int>.unmodifiable(list)));
+  }
+}
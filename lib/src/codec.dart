@@ -0,0 +1,410 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'mesh.dart';
+
+/// Vertex and index buffers restored by [MeshCodec.decode].
+class DecodedMesh {
+  const DecodedMesh(
+      this.positions, this.normals, this.tangents, this.uvs, this.indices);
+
+  /// The vertex positions, three floats per vertex.
+  final Float32List positions;
+
+  /// The unit vertex normals, three floats per vertex, if encoded.
+  final Float32List? normals;
+
+  /// The unit vertex tangents, three floats per vertex, if encoded.
+  final Float32List? tangents;
+
+  /// The texture coordinates, two floats per vertex, if encoded.
+  final Float32List? uvs;
+
+  /// The triangle indices.
+  final Uint32List indices;
+
+  /// The number of vertices.
+  int get vertexCount => positions.length ~/ 3;
+}
+
+/// A compact, versioned binary encoding of mesh buffers for storage and
+/// transfer.
+///
+/// - Positions are quantized to 16 bits per component against the mesh
+///   bounds. The error is at most 1/131070 of the extent of each axis.
+/// - Normals and tangents are octahedral-encoded into two signed 16-bit
+///   components.
+/// - Texture coordinates are quantized to 16 bits against their bounds.
+/// - Vertex streams are delta-encoded per component and split into byte
+///   planes, which makes them compress well.
+/// - Indices are delta-encoded, zigzag-encoded and stored as variable
+///   length integers.
+///
+/// The payload is compressed with zlib. All values are little endian.
+/// Decoding is a few linear passes over typed lists.
+class MeshCodec {
+  /// The format version written by [encode].
+  static const int version = 1;
+
+  /// The magic number at the start of encoded data: 'AMSH'.
+  static const int magic = 0x48534d41;
+
+  static const int _hasNormals = 0x1;
+  static const int _hasTangents = 0x2;
+  static const int _hasUvs = 0x4;
+  static const int _headerSize = 64;
+
+  /// Encodes the given buffers.
+  ///
+  /// [positions], [normals] and [tangents] hold three floats per vertex,
+  /// [uvs] two. Positions are quantized against [bounds] if given, which
+  /// must contain all positions, or otherwise against their own bounds.
+  /// [level] is the zlib compression level.
+  static Uint8List encode(Float32List positions, Uint32List indices,
+      {Float32List? normals,
+      Float32List? tangents,
+      Float32List? uvs,
+      Aabb3? bounds,
+      int level = 6}) {
+    final vertexCount = positions.length ~/ 3;
+    final min = Float32List(3), max = Float32List(3);
+    if (bounds != null) {
+      bounds.min.copyIntoArray(min);
+      bounds.max.copyIntoArray(max);
+    } else {
+      _bounds(positions, 3, min, max);
+    }
+    final uvMin = Float32List(2), uvMax = Float32List(2);
+    if (uvs != null) _bounds(uvs, 2, uvMin, uvMax);
+
+    final payload = BytesBuilder(copy: false);
+    final stream = Uint16List(vertexCount);
+    for (var k = 0; k < 3; ++k) {
+      _quantize(positions, 3, k, min[k], max[k], stream);
+      payload.add(_planes(stream));
+    }
+    for (final data in [normals, tangents]) {
+      if (data == null) continue;
+      final u = Uint16List(vertexCount), v = Uint16List(vertexCount);
+      _octEncode(data, u, v);
+      payload..add(_planes(u))..add(_planes(v));
+    }
+    if (uvs != null) {
+      for (var k = 0; k < 2; ++k) {
+        _quantize(uvs, 2, k, uvMin[k], uvMax[k], stream);
+        payload.add(_planes(stream));
+      }
+    }
+    payload.add(_encodeIndices(indices));
+    final compressed = ZLibCodec(level: level).encode(payload.takeBytes());
+
+    final header = ByteData(_headerSize);
+    header.setUint32(0, magic, Endian.little);
+    header.setUint16(4, version, Endian.little);
+    header.setUint16(
+        6,
+        (normals != null ? _hasNormals : 0) |
+            (tangents != null ? _hasTangents : 0) |
+            (uvs != null ? _hasUvs : 0),
+        Endian.little);
+    header.setUint32(8, vertexCount, Endian.little);
+    header.setUint32(12, indices.length, Endian.little);
+    for (var k = 0; k < 3; ++k) {
+      header.setFloat32(16 + k * 4, min[k], Endian.little);
+      header.setFloat32(28 + k * 4, max[k], Endian.little);
+    }
+    for (var k = 0; k < 2; ++k) {
+      header.setFloat32(40 + k * 4, uvMin[k], Endian.little);
+      header.setFloat32(48 + k * 4, uvMax[k], Endian.little);
+    }
+    header.setUint32(56, compressed.length, Endian.little);
+
+    final result = Uint8List(_headerSize + compressed.length);
+    result.setAll(0, header.buffer.asUint8List());
+    result.setAll(_headerSize, compressed);
+    return result;
+  }
+
+  /// Decodes data written by [encode].
+  ///
+  /// Throws a [FormatException] if [bytes] is not encoded mesh data, or of
+  /// a newer version.
+  static DecodedMesh decode(Uint8List bytes) {
+    if (bytes.length < _headerSize) {
+      throw const FormatException('Truncated mesh data');
+    }
+    final header = ByteData.sublistView(bytes, 0, _headerSize);
+    if (header.getUint32(0, Endian.little) != magic) {
+      throw const FormatException('Not encoded mesh data');
+    }
+    final dataVersion = header.getUint16(4, Endian.little);
+    if (dataVersion == 0 || dataVersion > version) {
+      throw FormatException('Unsupported mesh data version $dataVersion');
+    }
+    final flags = header.getUint16(6, Endian.little);
+    final vertexCount = header.getUint32(8, Endian.little);
+    final indexCount = header.getUint32(12, Endian.little);
+    final length = header.getUint32(56, Endian.little);
+    if (bytes.length < _headerSize + length) {
+      throw const FormatException('Truncated mesh data');
+    }
+    final payload = Uint8List.fromList(zlib.decode(
+        Uint8List.sublistView(bytes, _headerSize, _headerSize + length)));
+    // validate the counts before allocating from them; every index takes at
+    // least one byte
+    var streams = 3;
+    if (flags & _hasNormals != 0) streams += 2;
+    if (flags & _hasTangents != 0) streams += 2;
+    if (flags & _hasUvs != 0) streams += 2;
+    if (payload.length < vertexCount * 2 * streams + indexCount) {
+      throw const FormatException('Truncated mesh data');
+    }
+
+    var offset = 0;
+    final stream = Uint16List(vertexCount);
+    Uint16List next([Uint16List? out]) {
+      out ??= stream;
+      _unplanes(payload, offset, out);
+      offset += vertexCount * 2;
+      return out;
+    }
+
+    final positions = Float32List(vertexCount * 3);
+    for (var k = 0; k < 3; ++k) {
+      final min = header.getFloat32(16 + k * 4, Endian.little);
+      final max = header.getFloat32(28 + k * 4, Endian.little);
+      _dequantize(next(), min, max, positions, 3, k);
+    }
+    Float32List? octahedral(int flag) {
+      if (flags & flag == 0) return null;
+      final u = next(Uint16List(vertexCount));
+      final v = next(Uint16List(vertexCount));
+      return _octDecode(u, v);
+    }
+
+    final normals = octahedral(_hasNormals);
+    final tangents = octahedral(_hasTangents);
+    Float32List? uvs;
+    if (flags & _hasUvs != 0) {
+      uvs = Float32List(vertexCount * 2);
+      for (var k = 0; k < 2; ++k) {
+        final min = header.getFloat32(40 + k * 4, Endian.little);
+        final max = header.getFloat32(48 + k * 4, Endian.little);
+        _dequantize(next(), min, max, uvs, 2, k);
+      }
+    }
+    final indices = _decodeIndices(payload, offset, indexCount);
+    return DecodedMesh(positions, normals, tangents, uvs, indices);
+  }
+
+  static void _bounds(
+      Float32List data, int components, Float32List min, Float32List max) {
+    if (data.isEmpty) return;
+    for (var k = 0; k < components; ++k) {
+      min[k] = double.infinity;
+      max[k] = -double.infinity;
+    }
+    for (var i = 0; i < data.length; i += components) {
+      for (var k = 0; k < components; ++k) {
+        min[k] = math.min(min[k], data[i + k]);
+        max[k] = math.max(max[k], data[i + k]);
+      }
+    }
+  }
+
+  static void _quantize(Float32List data, int components, int k, double min,
+      double max, Uint16List out) {
+    final scale = max > min ? 65535 / (max - min) : 0.0;
+    for (var i = 0; i < out.length; ++i) {
+      final q = ((data[i * components + k] - min) * scale).round();
+      out[i] = q < 0 ? 0 : (q > 65535 ? 65535 : q);
+    }
+  }
+
+  static void _dequantize(Uint16List values, double min, double max,
+      Float32List out, int components, int k) {
+    final scale = (max - min) / 65535;
+    for (var i = 0, j = k; i < values.length; ++i, j += components) {
+      out[j] = min + values[i] * scale;
+    }
+  }
+
+  // Delta-encodes [values] and splits them into a plane of low bytes and a
+  // plane of high bytes.
+  static Uint8List _planes(Uint16List values) {
+    final n = values.length;
+    final out = Uint8List(n * 2);
+    var previous = 0;
+    for (var i = 0; i < n; ++i) {
+      final delta = (values[i] - previous) & 0xffff;
+      previous = values[i];
+      out[i] = delta & 0xff;
+      out[n + i] = delta >> 8;
+    }
+    return out;
+  }
+
+  static void _unplanes(Uint8List bytes, int offset, Uint16List out) {
+    final n = out.length;
+    if (bytes.length < offset + n * 2) {
+      throw const FormatException('Truncated mesh data');
+    }
+    var value = 0;
+    for (var i = 0; i < n; ++i) {
+      value = (value + (bytes[offset + i] | bytes[offset + n + i] << 8)) &
+          0xffff;
+      out[i] = value;
+    }
+  }
+
+  static void _octEncode(Float32List data, Uint16List u, Uint16List v) {
+    for (var i = 0; i < u.length; ++i) {
+      final x = data[i * 3], y = data[i * 3 + 1], z = data[i * 3 + 2];
+      final l1 = x.abs() + y.abs() + z.abs();
+      var a = l1 > 0 ? x / l1 : 0.0, b = l1 > 0 ? y / l1 : 0.0;
+      if (z < 0) {
+        final fa = (1 - b.abs()) * (a >= 0 ? 1 : -1);
+        final fb = (1 - a.abs()) * (b >= 0 ? 1 : -1);
+        a = fa;
+        b = fb;
+      }
+      u[i] = (a * 32767).round() & 0xffff;
+      v[i] = (b * 32767).round() & 0xffff;
+    }
+  }
+
+  static Float32List _octDecode(Uint16List u, Uint16List v) {
+    final out = Float32List(u.length * 3);
+    for (var i = 0; i < u.length; ++i) {
+      // sign-extend the 16-bit values
+      var x = ((u[i] ^ 0x8000) - 0x8000) / 32767;
+      var y = ((v[i] ^ 0x8000) - 0x8000) / 32767;
+      final z = 1 - x.abs() - y.abs();
+      final t = z < 0 ? -z : 0.0;
+      x += x >= 0 ? -t : t;
+      y += y >= 0 ? -t : t;
+      final length = math.sqrt(x * x + y * y + z * z);
+      out[i * 3] = x / length;
+      out[i * 3 + 1] = y / length;
+      out[i * 3 + 2] = z / length;
+    }
+    return out;
+  }
+
+  static Uint8List _encodeIndices(Uint32List indices) {
+    final out = BytesBuilder();
+    var previous = 0;
+    for (var i = 0; i < indices.length; ++i) {
+      final delta = indices[i] - previous;
+      previous = indices[i];
+      var zigzag = delta >= 0 ? delta * 2 : -delta * 2 - 1;
+      while (zigzag >= 0x80) {
+        out.addByte((zigzag & 0x7f) | 0x80);
+        zigzag >>= 7;
+      }
+      out.addByte(zigzag);
+    }
+    return out.takeBytes();
+  }
+
+  static Uint32List _decodeIndices(Uint8List bytes, int offset, int count) {
+    final out = Uint32List(count);
+    var previous = 0;
+    for (var i = 0; i < count; ++i) {
+      var zigzag = 0, shift = 0;
+      int byte;
+      do {
+        if (offset >= bytes.length) {
+          throw const FormatException('Truncated mesh data');
+        }
+        byte = bytes[offset++];
+        zigzag |= (byte & 0x7f) << shift;
+        shift += 7;
+      } while (byte >= 0x80);
+      previous += (zigzag & 1) == 0 ? zigzag >> 1 : -(zigzag >> 1) - 1;
+      out[i] = previous;
+    }
+    return out;
+  }
+}
+
+/// Encodes meshes with [MeshCodec].
+extension MeshEncode on Mesh {
+  /// Encodes the positions, normals, tangents, first UV channel and
+  /// indices of this mesh.
+  ///
+  /// Positions are quantized against [Mesh.aabb] if it was computed, see
+  /// [ProcessFlags.generateBoundingBoxes]. The indices are those of the
+  /// triangle faces, see [Mesh.triangleIndexData].
+  Uint8List encode({int level = 6}) {
+    final native = ptr.ref.mAABB;
+    final hasBounds = native.mMin.x < native.mMax.x ||
+        native.mMin.y < native.mMax.y ||
+        native.mMin.z < native.mMax.z;
+    var uvs = textureCoordData(0);
+    if (uvs != null) {
+      final components = uvComponents.first;
+      if (components != 2) {
+        final packed = Float32List(ptr.ref.mNumVertices * 2);
+        for (var i = 0; i < ptr.ref.mNumVertices; ++i) {
+          packed[i * 2] = uvs[i * components];
+          if (components > 1) packed[i * 2 + 1] = uvs[i * components + 1];
+        }
+        uvs = packed;
+      }
+    }
+    return MeshCodec.encode(vertexData, triangleIndexData,
+        normals: normalData,
+        tangents: tangentData,
+        uvs: uvs,
+        bounds: hasBounds ? aabb : null,
+        level: level);
+  }
+}
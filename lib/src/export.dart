@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
+import 'dart:async';
 import 'dart:ffi';
 import 'dart:typed_data';
 
@@ -48,6 +49,7 @@ import 'package:ffi/ffi.dart';
 
 import 'bindings.dart';
 import 'extensions.dart';
+import 'filesystem.dart';
 import 'libassimp.dart';
 import 'scene.dart';
 import 'type.dart';
@@ -162,16 +164,50 @@ extension SceneExport on Scene {
   /// @return a status code indicating the result of the export
   /// @note Use aiCopyScene() to get a modifiable copy of a previously
   ///   imported scene.
-  bool exportFile(String path, {required String format, int flags = 0}) {
+  ///
+  /// If a [fileSystem] is given, the exported file and any auxiliary files
+  /// are written to it instead of the disk.
+  bool exportFile(String path,
+      {required String format, int flags = 0, FileSystem? fileSystem}) {
     final cpath = path.toNativeString();
     final cformat = format.toNativeString();
-    // ### TODO: add custom io support
-    final res = libassimp.aiExportSceneEx(ptr, cformat, cpath, nullptr, flags);
+    final io = fileSystem != null
+        ? FileSystemBridge.allocate(fileSystem)
+        : nullptr.cast<aiFileIO>();
+    final res = libassimp.aiExportSceneEx(ptr, cformat, cpath, io, flags);
+    if (fileSystem != null) FileSystemBridge.free(io);
     malloc.free(cpath);
     malloc.free(cformat);
     return res == 0;
   }
 
+  /// Exports the scene in chunks to the sinks returned by [openSink].
+  ///
+  /// Unlike [exportData], the output is never materialized as a whole in
+  /// native memory. [openSink] is called with [path] for the primary file
+  /// and with the names of any auxiliary files the exporter writes (such as
+  /// OBJ materials or glTF buffers). Each sink is closed once its file is
+  /// complete. See [SinkFileSystem].
+  ///
+  /// Exporters that write sequentially, such as OBJ, STL, PLY and Collada,
+  /// are streamed. A file in which the exporter seeks before writing is
+  /// buffered in memory instead. Throws an [UnsupportedError] if the
+  /// exporter of [format] seeks back into data that was already streamed;
+  /// use [exportFile] or [exportData] for such formats.
+  bool exportToSink(
+      String path, StreamSink<List<int>> Function(String path) openSink,
+      {required String format, int flags = 0}) {
+    final fileSystem = SinkFileSystem(openSink);
+    final result = exportFile(path,
+        format: format, flags: flags, fileSystem: fileSystem);
+    if (fileSystem.unseekable.isNotEmpty) {
+      throw UnsupportedError('The $format exporter seeks back in '
+          '${fileSystem.unseekable.first}, which cannot be streamed; use '
+          'exportFile or exportData instead');
+    }
+    return result;
+  }
+
   /// Exports the given scene to a chosen file format. Returns the exported data as a binary blob which
   /// you can write into a file or something. When you're done with the data, use #aiReleaseExportBlob()
   /// to free the resources associated with the export.
@@ -186,4 +222,14 @@ extension SceneExport on Scene {
     malloc.free(cformat);
     return ExportData.fromNative(data);
   }
+
+  /// Writes the scene to a binary snapshot that can be loaded with
+  /// [Scene.fromSnapshot].
+  ///
+  /// A snapshot stores the complete scene as is, including the results of
+  /// any post-processing, in Assimp's versioned `assbin` format. Loading it
+  /// skips the original importer and post-processing steps.
+  bool saveSnapshot(String path) {
+    return exportFile(path, format: Scene.snapshotFormat);
+  }
 }
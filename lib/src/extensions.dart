@@ -43,11 +43,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import 'dart:convert';
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:vector_math/vector_math.dart';
 export 'package:vector_math/vector_math.dart'
-    show Aabb3, Matrix3, Matrix4, Quaternion, Vector2, Vector3, Vector4;
+    show
+        Aabb3,
+        Frustum,
+        Matrix3,
+        Matrix4,
+        Quaternion,
+        Ray,
+        Vector2,
+        Vector3,
+        Vector4;
 
 import 'bindings.dart';
 
@@ -156,6 +166,27 @@ extension AssimpMatrix4 on aiMatrix4x4 {
     d3 = matrix.row3.z;
     d4 = matrix.row3.w;
   }
+
+  /// Copies this row-major matrix into [storage] at [offset], in the
+  /// column-major order of [Matrix4.storage].
+  void copyIntoStorage(Float32List storage, [int offset = 0]) {
+    storage[offset + 0] = a1;
+    storage[offset + 1] = b1;
+    storage[offset + 2] = c1;
+    storage[offset + 3] = d1;
+    storage[offset + 4] = a2;
+    storage[offset + 5] = b2;
+    storage[offset + 6] = c2;
+    storage[offset + 7] = d2;
+    storage[offset + 8] = a3;
+    storage[offset + 9] = b3;
+    storage[offset + 10] = c3;
+    storage[offset + 11] = d3;
+    storage[offset + 12] = a4;
+    storage[offset + 13] = b4;
+    storage[offset + 14] = c4;
+    storage[offset + 15] = d4;
+  }
 }
 
 extension DartMatrix4 on Matrix4 {
@@ -220,7 +251,51 @@ extension AssimpStringArray on Pointer<Int8> {
 
 extension AssimpString on String {
   static String fromNative(aiString ai) {
-    return utf8.decode(List<int>.generate(ai.length, (i) => ai.data[i]));
+    final length = ai.length;
+    final bytes = Uint8List(length);
+    for (var i = 0; i < length; ++i) {
+      bytes[i] = ai.data[i];
+    }
+    return _decode(bytes);
+  }
+
+  /// Decodes the string at [ptr] straight from native memory.
+  ///
+  /// Unlike [fromNative], which copies the bytes one by one through the
+  /// struct accessors, this reads them through a typed view. ASCII strings,
+  /// which most node, bone and channel names are, skip the UTF-8 decoder.
+  ///
+  /// The name is the first member of aiNode, aiBone, aiNodeAnim and
+  /// aiMaterialProperty, so pointers to those cast to a pointer to their
+  /// name.
+  static String fromPointer(Pointer<aiString> ptr) {
+    final length = ptr.ref.length;
+    if (length == 0) return '';
+    final bytes =
+        ptr.cast<Uint8>().elementAt(sizeOf<Uint32>()).asTypedList(length);
+    return _decode(bytes);
+  }
+
+  // ASCII strings, which most names are, skip the UTF-8 decoder.
+  static String _decode(Uint8List bytes) {
+    if (_isAscii(bytes)) return String.fromCharCodes(bytes);
+    return utf8.decode(bytes);
+  }
+
+  static bool _isAscii(Uint8List bytes) {
+    var i = 0;
+    if (bytes.offsetInBytes % 4 == 0) {
+      final words =
+          bytes.buffer.asUint32List(bytes.offsetInBytes, bytes.length ~/ 4);
+      for (; i < words.length; ++i) {
+        if (words[i] & 0x80808080 != 0) return false;
+      }
+      i *= 4;
+    }
+    for (; i < bytes.length; ++i) {
+      if (bytes[i] >= 0x80) return false;
+    }
+    return true;
   }
 
   Pointer<aiString> toNative() {
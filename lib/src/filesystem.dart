@@ -0,0 +1,674 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+import 'bindings.dart';
+import 'extensions.dart';
+
+/// A virtual file system that Assimp reads model files from.
+///
+/// By default, Assimp reads files from the disk. Pass a [FileSystem] to
+/// [Scene.fromFile] to resolve the model file and any files it references
+/// (materials, buffers, textures) from another source, such as memory or a
+/// packed archive.
+///
+/// A [FileSystem] can also be passed to [SceneExport.exportFile] to write
+/// the exported file and any auxiliary files (such as OBJ materials).
+///
+/// Implementations are called synchronously on the isolate that runs the
+/// import or export.
+abstract class FileSystem {
+  const FileSystem();
+
+  /// Opens the file at [path] in the given fopen()-style [mode] (for example
+  /// `rb` or `wb`).
+  ///
+  /// Returns `null` if the file does not exist or cannot be opened. Assimp
+  /// also uses this to probe whether a file exists.
+  FileHandle? open(String path, String mode);
+
+  /// Normalizes [path] for lookups: converts backslashes to forward slashes
+  /// and resolves `.` and `..` segments.
+  static String normalize(String path) {
+    final segments = <String>[];
+    for (final segment in path.replaceAll('\\', '/').split('/')) {
+      if (segment.isEmpty || segment == '.') continue;
+      if (segment == '..' && segments.isNotEmpty && segments.last != '..') {
+        segments.removeLast();
+      } else {
+        segments.add(segment);
+      }
+    }
+    final absolute = path.startsWith('/') || path.startsWith('\\');
+    return (absolute ? '/' : '') + segments.join('/');
+  }
+}
+
+/// An open file in a [FileSystem].
+abstract class FileHandle {
+  const FileHandle();
+
+  /// The size of the file, in bytes.
+  int get length;
+
+  /// The current position of the file cursor.
+  int get position;
+
+  /// Moves the file cursor to [position].
+  ///
+  /// Returns `false` if the position is out of range.
+  bool setPosition(int position);
+
+  /// Reads up to `buffer.length` bytes into [buffer] at the file cursor and
+  /// advances the cursor.
+  ///
+  /// Returns the number of bytes read.
+  int read(Uint8List buffer);
+
+  /// Writes [data] at the file cursor and advances the cursor.
+  ///
+  /// Returns the number of bytes written. Read-only files return 0.
+  int write(Uint8List data) => 0;
+
+  /// Flushes any buffered writes.
+  void flush() {}
+
+  /// Closes the file.
+  void close() {}
+}
+
+/// A [FileSystem] that serves files from memory.
+///
+/// Files written by Assimp (for example, by an export) are stored back into
+/// [files] when they are closed.
+class MemoryFileSystem extends FileSystem {
+  /// Creates a file system with the given [files], keyed by path.
+  MemoryFileSystem([Map<String, Uint8List> files = const {}]) {
+    files.forEach((path, bytes) => this[path] = bytes);
+  }
+
+  final _files = <String, Uint8List>{};
+
+  /// The files in this file system, keyed by normalized path.
+  Map<String, Uint8List> get files => Map.unmodifiable(_files);
+
+  /// Returns the contents of the file at [path], or `null` if none.
+  Uint8List? operator [](String path) => _files[FileSystem.normalize(path)];
+
+  /// Adds or replaces the file at [path].
+  void operator []=(String path, Uint8List bytes) {
+    _files[FileSystem.normalize(path)] = bytes;
+  }
+
+  /// Removes the file at [path].
+  Uint8List? remove(String path) => _files.remove(FileSystem.normalize(path));
+
+  @override
+  FileHandle? open(String path, String mode) {
+    final key = FileSystem.normalize(path);
+    if (mode.startsWith('w')) {
+      return _MemoryWriter((bytes) => _files[key] = bytes);
+    }
+    final bytes = _files[key];
+    if (bytes == null) return null;
+    return _MemoryReader(() => bytes);
+  }
+}
+
+/// A read-only [FileSystem] that serves files from a ZIP archive.
+///
+/// Supports stored and deflated entries. Entries are decompressed on first
+/// read, so probing a file for existence is cheap.
+class ZipFileSystem extends FileSystem {
+  /// Opens the ZIP archive contained in [bytes].
+  ///
+  /// Throws a [FormatException] if [bytes] is not a valid ZIP archive.
+  ZipFileSystem(this.bytes) {
+    _readCentralDirectory();
+  }
+
+  /// Opens the ZIP archive at [path].
+  factory ZipFileSystem.fromFile(String path) {
+    return ZipFileSystem(File(path).readAsBytesSync());
+  }
+
+  /// The raw archive data.
+  final Uint8List bytes;
+
+  final _entries = <String, _ZipEntry>{};
+
+  /// The normalized paths of the files in the archive.
+  Iterable<String> get paths => _entries.keys;
+
+  @override
+  FileHandle? open(String path, String mode) {
+    if (!mode.startsWith('r')) return null;
+    final entry = _entries[FileSystem.normalize(path)];
+    if (entry == null) return null;
+    return _ZipReader(entry);
+  }
+
+  static const _eocdSignature = 0x06054b50;
+  static const _centralSignature = 0x02014b50;
+  static const _localSignature = 0x04034b50;
+
+  void _readCentralDirectory() {
+    final data = ByteData.sublistView(bytes);
+    final limit = math.max(0, bytes.length - 22 - 0xffff);
+    var eocd = bytes.length - 22;
+    while (eocd >= limit &&
+        data.getUint32(eocd, Endian.little) != _eocdSignature) {
+      --eocd;
+    }
+    if (eocd < limit) throw const FormatException('Not a ZIP archive');
+    final count = data.getUint16(eocd + 10, Endian.little);
+    var offset = data.getUint32(eocd + 16, Endian.little);
+    if (count == 0xffff || offset == 0xffffffff) {
+      throw const FormatException('ZIP64 archives are not supported');
+    }
+    for (var i = 0; i < count; ++i) {
+      if (data.getUint32(offset, Endian.little) != _centralSignature) {
+        throw const FormatException('Corrupt ZIP central directory');
+      }
+      final method = data.getUint16(offset + 10, Endian.little);
+      final compressedSize = data.getUint32(offset + 20, Endian.little);
+      final size = data.getUint32(offset + 24, Endian.little);
+      final nameLength = data.getUint16(offset + 28, Endian.little);
+      final extraLength = data.getUint16(offset + 30, Endian.little);
+      final commentLength = data.getUint16(offset + 32, Endian.little);
+      final header = data.getUint32(offset + 42, Endian.little);
+      final name = utf8.decode(
+          Uint8List.sublistView(bytes, offset + 46, offset + 46 + nameLength),
+          allowMalformed: true);
+      offset += 46 + nameLength + extraLength + commentLength;
+      if (name.endsWith('/')) continue;
+      _entries[FileSystem.normalize(name)] =
+          _ZipEntry(this, method, header, compressedSize, size);
+    }
+  }
+}
+
+/// A [FileSystem] that reads and writes files on the disk below [root].
+///
+/// Files are accessed with synchronous [RandomAccessFile] operations, so
+/// exported data goes straight to the disk in the chunks Assimp writes,
+/// without being buffered in memory.
+class DirectoryFileSystem extends FileSystem {
+  /// Creates a file system that resolves relative paths against [root].
+  const DirectoryFileSystem([this.root = '.']);
+
+  /// The directory that relative paths are resolved against.
+  final String root;
+
+  @override
+  FileHandle? open(String path, String mode) {
+    var file = File(path);
+    if (!file.isAbsolute) file = File('$root/$path');
+    try {
+      if (mode.startsWith('w')) {
+        return _DiskFile(file.openSync(mode: FileMode.write));
+      }
+      if (mode.startsWith('a')) {
+        return _DiskFile(file.openSync(mode: FileMode.append));
+      }
+      return _DiskFile(file.openSync());
+    } on FileSystemException {
+      return null;
+    }
+  }
+}
+
+/// A write-only [FileSystem] that streams written files into sinks.
+///
+/// Each file opened for writing is forwarded to the sink returned by
+/// [openSink] for its path, in chunks of up to [chunkSize] bytes, and the
+/// sink is closed when Assimp closes the file. Writing is synchronous, so a
+/// sink that processes data asynchronously (such as an [IOSink]) buffers
+/// the chunks until the export returns; use [DirectoryFileSystem] to write
+/// to the disk as the export progresses.
+///
+/// Sinks cannot be rewound. If an exporter seeks before any data of a file
+/// reached its sink, that file is kept in memory and passed to the sink
+/// when it is closed. Seeking into data that was already passed to the
+/// sink fails, and the path is added to [unseekable].
+class SinkFileSystem extends FileSystem {
+  /// Creates a file system that writes each file to `openSink(path)`.
+  SinkFileSystem(this.openSink, {this.chunkSize = 64 * 1024});
+
+  /// Returns the sink for the file at the given path.
+  final StreamSink<List<int>> Function(String path) openSink;
+
+  /// The maximum size of a chunk passed to a sink.
+  final int chunkSize;
+
+  final _unseekable = <String>[];
+
+  /// The paths of the files in which a seek failed because the data had
+  /// already been passed to the sink.
+  List<String> get unseekable => List.unmodifiable(_unseekable);
+
+  @override
+  FileHandle? open(String path, String mode) {
+    if (!mode.startsWith('w')) return null;
+    return _SinkWriter(
+        openSink(path), chunkSize, () => _unseekable.add(path));
+  }
+}
+
+class _ZipEntry {
+  final ZipFileSystem archive;
+  final int method;
+  final int header;
+  final int compressedSize;
+  final int size;
+
+  _ZipEntry(
+      this.archive, this.method, this.header, this.compressedSize, this.size);
+
+  Uint8List extract() {
+    final bytes = archive.bytes;
+    final data = ByteData.sublistView(bytes);
+    final signature = data.getUint32(header, Endian.little);
+    if (signature != ZipFileSystem._localSignature) {
+      throw const FormatException('Corrupt ZIP local header');
+    }
+    final start = header +
+        30 +
+        data.getUint16(header + 26, Endian.little) +
+        data.getUint16(header + 28, Endian.little);
+    final compressed = Uint8List.sublistView(
+        bytes, start, start + compressedSize);
+    switch (method) {
+      case 0:
+        return compressed;
+      case 8:
+        final inflated = ZLibDecoder(raw: true).convert(compressed);
+        return inflated is Uint8List ? inflated : Uint8List.fromList(inflated);
+      default:
+        throw FormatException('Unsupported ZIP compression method: $method');
+    }
+  }
+}
+
+class _MemoryReader extends FileHandle {
+  final Uint8List Function() _load;
+  Uint8List? _bytes;
+  int _position = 0;
+
+  _MemoryReader(this._load);
+
+  Uint8List get bytes => _bytes ??= _load();
+
+  @override
+  int get length => bytes.length;
+
+  @override
+  int get position => _position;
+
+  @override
+  bool setPosition(int position) {
+    if (position < 0 || position > length) return false;
+    _position = position;
+    return true;
+  }
+
+  @override
+  int read(Uint8List buffer) {
+    final count = math.min(buffer.length, length - _position);
+    buffer.setRange(0, count, bytes, _position);
+    _position += count;
+    return count;
+  }
+}
+
+class _ZipReader extends _MemoryReader {
+  final _ZipEntry entry;
+
+  _ZipReader(this.entry) : super(entry.extract);
+
+  @override
+  int get length => entry.size;
+}
+
+class _MemoryWriter extends FileHandle {
+  final void Function(Uint8List bytes) onClose;
+  Uint8List _buffer = Uint8List(4096);
+  int _length = 0;
+  int _position = 0;
+
+  _MemoryWriter(this.onClose);
+
+  @override
+  int get length => _length;
+
+  @override
+  int get position => _position;
+
+  @override
+  bool setPosition(int position) {
+    if (position < 0) return false;
+    _position = position;
+    return true;
+  }
+
+  @override
+  int read(Uint8List buffer) {
+    final count = math.max(0, math.min(buffer.length, _length - _position));
+    buffer.setRange(0, count, _buffer, _position);
+    _position += count;
+    return count;
+  }
+
+  @override
+  int write(Uint8List data) {
+    final end = _position + data.length;
+    if (end > _buffer.length) {
+      final grown = Uint8List(math.max(end, _buffer.length * 2));
+      grown.setRange(0, _length, _buffer);
+      _buffer = grown;
+    }
+    _buffer.setRange(_position, end, data);
+    _position = end;
+    _length = math.max(_length, end);
+    return data.length;
+  }
+
+  @override
+  void close() => onClose(Uint8List.sublistView(_buffer, 0, _length));
+}
+
+class _DiskFile extends FileHandle {
+  final RandomAccessFile file;
+
+  _DiskFile(this.file);
+
+  @override
+  int get length => file.lengthSync();
+
+  @override
+  int get position => file.positionSync();
+
+  @override
+  bool setPosition(int position) {
+    if (position < 0) return false;
+    file.setPositionSync(position);
+    return true;
+  }
+
+  @override
+  int read(Uint8List buffer) => file.readIntoSync(buffer);
+
+  @override
+  int write(Uint8List data) {
+    file.writeFromSync(data);
+    return data.length;
+  }
+
+  @override
+  void flush() => file.flushSync();
+
+  @override
+  void close() => file.closeSync();
+}
+
+class _SinkWriter extends FileHandle {
+  final StreamSink<List<int>> sink;
+  final void Function() onUnseekable;
+  final Uint8List _chunk;
+  int _pending = 0;
+  int _position = 0;
+  bool _streamed = false;
+  // Holds the whole file once the exporter seeks before streaming.
+  _MemoryWriter? _buffer;
+
+  _SinkWriter(this.sink, int chunkSize, this.onUnseekable)
+      : _chunk = Uint8List(chunkSize);
+
+  @override
+  int get length => _buffer?.length ?? _position;
+
+  @override
+  int get position => _buffer?.position ?? _position;
+
+  @override
+  bool setPosition(int position) {
+    final buffer = _buffer;
+    if (buffer != null) return buffer.setPosition(position);
+    if (position == _position) return true;
+    if (_streamed) {
+      onUnseekable();
+      return false;
+    }
+    final memory = _MemoryWriter(_emit);
+    memory.write(Uint8List.sublistView(_chunk, 0, _pending));
+    _pending = 0;
+    _buffer = memory;
+    return memory.setPosition(position);
+  }
+
+  @override
+  int read(Uint8List buffer) => 0;
+
+  @override
+  int write(Uint8List data) {
+    final buffer = _buffer;
+    if (buffer != null) return buffer.write(data);
+    var offset = 0;
+    while (offset < data.length) {
+      final count = math.min(data.length - offset, _chunk.length - _pending);
+      _chunk.setRange(_pending, _pending + count, data, offset);
+      _pending += count;
+      offset += count;
+      if (_pending == _chunk.length) flush();
+    }
+    _position += data.length;
+    return data.length;
+  }
+
+  @override
+  void flush() {
+    if (_pending == 0 || _buffer != null) return;
+    sink.add(Uint8List.fromList(Uint8List.sublistView(_chunk, 0, _pending)));
+    _pending = 0;
+    _streamed = true;
+  }
+
+  @override
+  void close() {
+    final buffer = _buffer;
+    if (buffer != null) {
+      buffer.close();
+    } else {
+      flush();
+    }
+    sink.close();
+  }
+
+  void _emit(Uint8List bytes) {
+    for (var offset = 0; offset < bytes.length; offset += _chunk.length) {
+      final end = math.min(bytes.length, offset + _chunk.length);
+      sink.add(Uint8List.fromList(Uint8List.sublistView(bytes, offset, end)));
+    }
+  }
+}
+
+/// Bridges a [FileSystem] to Assimp's `aiFileIO` callbacks.
+///
+/// The callbacks are plain FFI trampolines that look up the Dart objects by
+/// the id stored in `UserData`, so they must be invoked synchronously on the
+/// isolate that created the `aiFileIO` - which is the case for imports and
+/// exports, as both run to completion within the calling FFI call.
+class FileSystemBridge {
+  FileSystemBridge._();
+
+  static final _systems = <int, FileSystem>{};
+  static final _files = <int, FileHandle>{};
+  static var _nextId = 0;
+
+  static const _aiReturnSuccess = 0;
+  static const _aiReturnFailure = -1;
+
+  static const _aiOriginSet = 0;
+  static const _aiOriginCur = 1;
+  static const _aiOriginEnd = 2;
+
+  static final _openProc = Pointer.fromFunction<aiFileOpenProc>(_open);
+  static final _closeProc = Pointer.fromFunction<aiFileCloseProc>(_close);
+  static final _readProc = Pointer.fromFunction<aiFileReadProc>(_read, 0);
+  static final _writeProc = Pointer.fromFunction<aiFileWriteProc>(_write, 0);
+  static final _tellProc = Pointer.fromFunction<aiFileTellProc>(_tell, 0);
+  static final _sizeProc = Pointer.fromFunction<aiFileTellProc>(_size, 0);
+  static final _seekProc =
+      Pointer.fromFunction<aiFileSeek>(_seek, _aiReturnFailure);
+  static final _flushProc = Pointer.fromFunction<aiFileFlushProc>(_flush);
+
+  /// @internal
+  ///
+  /// Allocates an `aiFileIO` that forwards to [fileSystem]. Release it with
+  /// [free] once the import or export has returned.
+  static Pointer<aiFileIO> allocate(FileSystem fileSystem) {
+    final id = ++_nextId;
+    _systems[id] = fileSystem;
+    final io = calloc<aiFileIO>();
+    io.ref.OpenProc = _openProc;
+    io.ref.CloseProc = _closeProc;
+    io.ref.UserData = Pointer<Int8>.fromAddress(id);
+    return io;
+  }
+
+  /// @internal
+  static void free(Pointer<aiFileIO> io) {
+    _systems.remove(io.ref.UserData.address);
+    calloc.free(io);
+  }
+
+  static Pointer<aiFile> _open(
+      Pointer<aiFileIO> io, Pointer<Int8> path, Pointer<Int8> mode) {
+    final fileSystem = _systems[io.ref.UserData.address];
+    if (fileSystem == null) return nullptr;
+    FileHandle? handle;
+    try {
+      handle = fileSystem.open(path.toDartString(), mode.toDartString());
+    } catch (_) {
+      handle = null;
+    }
+    if (handle == null) return nullptr;
+    final id = ++_nextId;
+    _files[id] = handle;
+    final file = calloc<aiFile>();
+    file.ref.ReadProc = _readProc;
+    file.ref.WriteProc = _writeProc;
+    file.ref.TellProc = _tellProc;
+    file.ref.FileSizeProc = _sizeProc;
+    file.ref.SeekProc = _seekProc;
+    file.ref.FlushProc = _flushProc;
+    file.ref.UserData = Pointer<Int8>.fromAddress(id);
+    return file;
+  }
+
+  static void _close(Pointer<aiFileIO> io, Pointer<aiFile> file) {
+    final handle = _files.remove(file.ref.UserData.address);
+    calloc.free(file);
+    try {
+      handle?.close();
+    } catch (_) {
+      // errors cannot be reported back through aiFileIO
+    }
+  }
+
+  static FileHandle? _handle(Pointer<aiFile> file) =>
+      _files[file.ref.UserData.address];
+
+  static int _read(
+      Pointer<aiFile> file, Pointer<Int8> buffer, int size, int count) {
+    final handle = _handle(file);
+    if (handle == null || size <= 0 || count <= 0) return 0;
+    final available = handle.length - handle.position;
+    final elements = math.min(count, available ~/ size);
+    if (elements <= 0) return 0;
+    final bytes = buffer.cast<Uint8>().asTypedList(elements * size);
+    return handle.read(bytes) ~/ size;
+  }
+
+  static int _write(
+      Pointer<aiFile> file, Pointer<Int8> buffer, int size, int count) {
+    final handle = _handle(file);
+    if (handle == null || size <= 0 || count <= 0) return 0;
+    final bytes = buffer.cast<Uint8>().asTypedList(size * count);
+    return handle.write(bytes) ~/ size;
+  }
+
+  static int _tell(Pointer<aiFile> file) => _handle(file)?.position ?? 0;
+
+  static int _size(Pointer<aiFile> file) => _handle(file)?.length ?? 0;
+
+  static int _seek(Pointer<aiFile> file, int offset, int origin) {
+    final handle = _handle(file);
+    if (handle == null) return _aiReturnFailure;
+    int position;
+    switch (origin) {
+      case _aiOriginSet:
+        position = offset;
+        break;
+      case _aiOriginCur:
+        position = handle.position + offset;
+        break;
+      case _aiOriginEnd:
+        position = handle.length + offset;
+        break;
+      default:
+        return _aiReturnFailure;
+    }
+    return handle.setPosition(position) ? _aiReturnSuccess : _aiReturnFailure;
+  }
+
+  static void _flush(Pointer<aiFile> file) => _handle(file)?.flush();
+}
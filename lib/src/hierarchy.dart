@@ -0,0 +1,241 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'bindings.dart';
+import 'extensions.dart';
+import 'names.dart';
+import 'node.dart';
+
+/// A node hierarchy flattened into parallel arrays.
+///
+/// Nodes are stored in depth-first preorder, so every parent precedes its
+/// children and the descendants of node `i` are the nodes from `i + 1` up to
+/// (not including) `subtreeEnds[i]`. Matrices are packed as 16 floats per
+/// node in the column-major order of [Matrix4.storage].
+///
+/// The arrays are copies of the native data. Changing [locals] does not
+/// modify the scene, and changing the scene does not update the arrays.
+class FlatHierarchy {
+  FlatHierarchy._(
+      this.parents,
+      this.subtreeEnds,
+      this.nameIds,
+      this.nameTable,
+      this.locals,
+      this.worlds,
+      this.meshOffsets,
+      this.meshIndices);
+
+  /// Flattens the hierarchy below and including [root].
+  ///
+  /// The node names are interned into [names], or into a new table if not
+  /// given. Pass the table of the scene, such as [CachedScene.names], to get
+  /// [nameIds] that are shared with bone and channel lookups.
+  factory FlatHierarchy.fromNode(Node root, {NameTable? names}) {
+    final nodes = <Pointer<aiNode>>[];
+    final parentList = <int>[];
+    final stack = <Pointer<aiNode>>[root.ptr];
+    final parentStack = <int>[-1];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final index = nodes.length;
+      nodes.add(node);
+      parentList.add(parentStack.removeLast());
+      final children = node.ref.mChildren;
+      for (var i = node.ref.mNumChildren - 1; i >= 0; --i) {
+        stack.add(children[i]);
+        parentStack.add(index);
+      }
+    }
+
+    final count = nodes.length;
+    final parents = Int32List.fromList(parentList);
+    final subtreeEnds = Int32List(count);
+    for (var i = count - 1; i >= 0; --i) {
+      if (subtreeEnds[i] == 0) subtreeEnds[i] = i + 1;
+      final parent = parents[i];
+      if (parent >= 0 && subtreeEnds[parent] < subtreeEnds[i]) {
+        subtreeEnds[parent] = subtreeEnds[i];
+      }
+    }
+
+    final nameTable = names ?? NameTable();
+    final nameIds = Int32List(count);
+    final locals = Float32List(count * 16);
+    final meshOffsets = Int32List(count + 1);
+    var meshCount = 0;
+    for (var i = 0; i < count; ++i) {
+      final node = nodes[i].ref;
+      // mName is the first member of aiNode.
+      nameIds[i] = nameTable.internNative(nodes[i].cast());
+      node.mTransformation.copyIntoStorage(locals, i * 16);
+      meshCount += node.mNumMeshes;
+      meshOffsets[i + 1] = meshCount;
+    }
+    final meshIndices = Uint32List(meshCount);
+    for (var i = 0; i < count; ++i) {
+      final node = nodes[i].ref;
+      if (node.mNumMeshes == 0) continue;
+      meshIndices.setAll(
+          meshOffsets[i], node.mMeshes.asTypedList(node.mNumMeshes));
+    }
+
+    final hierarchy = FlatHierarchy._(
+        parents,
+        subtreeEnds,
+        nameIds,
+        nameTable,
+        locals,
+        Float32List(count * 16),
+        meshOffsets,
+        meshIndices);
+    hierarchy.updateWorldTransforms();
+    return hierarchy;
+  }
+
+  /// The index of the parent of each node, or -1 for the root.
+  final Int32List parents;
+
+  /// The exclusive end index of the subtree of each node.
+  final Int32List subtreeEnds;
+
+  /// The [nameTable] id of the name of each node.
+  final Int32List nameIds;
+
+  /// The table the node names are interned in.
+  final NameTable nameTable;
+
+  /// The interned names, indexed by the ids in [nameIds].
+  List<String> get names => nameTable.names;
+
+  /// The transformation of each node relative to its parent.
+  final Float32List locals;
+
+  /// The transformation of each node relative to the root.
+  final Float32List worlds;
+
+  /// The start index into [meshIndices] of the meshes of each node, plus a
+  /// final entry for the total count. The meshes of node `i` are
+  /// `meshIndices[meshOffsets[i]]` up to `meshIndices[meshOffsets[i + 1]]`.
+  final Int32List meshOffsets;
+
+  /// The mesh indices of all nodes, see [meshOffsets].
+  final Uint32List meshIndices;
+
+  /// The number of nodes.
+  int get length => parents.length;
+
+  /// The name of the node at [index].
+  String nameOf(int index) => nameTable.nameOf(nameIds[index]);
+
+  /// Returns the index of the first node called [name], or -1 if none.
+  int indexOf(String name) {
+    final id = nameTable.idOf(name);
+    return id < 0 ? -1 : nameIds.indexOf(id);
+  }
+
+  /// A view of the local transformation of the node at [index].
+  Matrix4 local(int index) => _view(locals, index);
+
+  /// A view of the world transformation of the node at [index].
+  Matrix4 world(int index) => _view(worlds, index);
+
+  static Matrix4 _view(Float32List matrices, int index) {
+    return Matrix4.fromBuffer(
+        matrices.buffer, matrices.offsetInBytes + index * 64);
+  }
+
+  /// Recomputes [worlds] from [locals].
+  ///
+  /// Only the subtrees of the [dirty] nodes are updated, or all nodes if
+  /// not given.
+  void updateWorldTransforms([Iterable<int>? dirty]) {
+    if (dirty == null) {
+      _update(0, length);
+      return;
+    }
+    final sorted = dirty.toList()..sort();
+    var end = 0;
+    for (final index in sorted) {
+      if (index < end) continue;
+      end = subtreeEnds[index];
+      _update(index, end);
+    }
+  }
+
+  void _update(int start, int end) {
+    for (var i = start; i < end; ++i) {
+      final parent = parents[i];
+      if (parent < 0) {
+        worlds.setRange(i * 16, i * 16 + 16, locals, i * 16);
+      } else {
+        _multiply(worlds, parent * 16, locals, i * 16, worlds, i * 16);
+      }
+    }
+  }
+
+  // out = a * b for column-major 4x4 matrices.
+  static void _multiply(Float32List a, int ao, Float32List b, int bo,
+      Float32List out, int oo) {
+    final a00 = a[ao], a01 = a[ao + 4], a02 = a[ao + 8], a03 = a[ao + 12];
+    final a10 = a[ao + 1], a11 = a[ao + 5], a12 = a[ao + 9];
+    final a13 = a[ao + 13];
+    final a20 = a[ao + 2], a21 = a[ao + 6], a22 = a[ao + 10];
+    final a23 = a[ao + 14];
+    final a30 = a[ao + 3], a31 = a[ao + 7], a32 = a[ao + 11];
+    final a33 = a[ao + 15];
+    for (var c = 0; c < 16; c += 4) {
+      final b0 = b[bo + c], b1 = b[bo + c + 1];
+      final b2 = b[bo + c + 2], b3 = b[bo + c + 3];
+      out[oo + c] = a00 * b0 + a01 * b1 + a02 * b2 + a03 * b3;
+      out[oo + c + 1] = a10 * b0 + a11 * b1 + a12 * b2 + a13 * b3;
+      out[oo + c + 2] = a20 * b0 + a21 * b1 + a22 * b2 + a23 * b3;
+      out[oo + c + 3] = a30 * b0 + a31 * b1 + a32 * b2 + a33 * b3;
+    }
+  }
+}
@@ -0,0 +1,225 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:async';
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+
+import 'bindings.dart';
+import 'extensions.dart';
+import 'libassimp.dart';
+import 'pool.dart';
+
+/// The severity of a [LogMessage].
+enum LogSeverity { debug, info, warn, error }
+
+/// A message from Assimp's logger.
+class LogMessage {
+  const LogMessage(this.severity, this.thread, this.text);
+
+  /// Parses a raw log line such as `Info,  T0: Load file.obj`.
+  ///
+  /// Lines that do not follow the logger format are reported as
+  /// [LogSeverity.info] messages.
+  factory LogMessage.parse(String line) {
+    final match = _pattern.firstMatch(line.trimRight());
+    if (match == null) return LogMessage(LogSeverity.info, 0, line.trimRight());
+    return LogMessage(_severities[match.group(1)]!,
+        int.parse(match.group(2)!), match.group(3)!);
+  }
+
+  /// The severity of the message.
+  final LogSeverity severity;
+
+  /// The id of the logging thread.
+  final int thread;
+
+  /// The message text, without the severity and thread prefix.
+  final String text;
+
+  static final _pattern =
+      RegExp(r'^(Debug|Info|Warn|Error),\s+T(\d+): (.*)$', dotAll: true);
+
+  static const _severities = {
+    'Debug': LogSeverity.debug,
+    'Info': LogSeverity.info,
+    'Warn': LogSeverity.warn,
+    'Error': LogSeverity.error,
+  };
+
+  @override
+  String toString() => '${severity.toString().split('.').last}: $text';
+}
+
+/// A timed region reported by Assimp's profiler.
+///
+/// Assimp measures the `total`, `import`, `preprocess`, `validate` and
+/// `postprocess` regions of an import when the [AI_CONFIG_GLOB_MEASURE_TIME]
+/// import property is set and verbose logging is enabled. Post-processing is
+/// timed per step, in which case [step] names the Assimp process class,
+/// such as `JoinVerticesProcess`.
+class TimingEvent {
+  const TimingEvent(this.region, this.elapsed, [this.step]);
+
+  /// The name of the profiled region.
+  final String region;
+
+  /// The time spent in the region.
+  final Duration elapsed;
+
+  /// The post-processing step that ran in the region, if known.
+  final String? step;
+
+  @override
+  String toString() =>
+      'TimingEvent($region${step != null ? ' $step' : ''}: '
+      '${elapsed.inMicroseconds} us)';
+}
+
+/// Captures Assimp's log output.
+///
+/// Messages are collected while Assimp runs and delivered to [messages] and
+/// [timings] asynchronously, so listeners never run inside an import.
+///
+/// Assimp's logger is global to the process and invokes every attached
+/// stream on the thread that logs, while the log callback can only be
+/// invoked on the thread of the isolate that attached it. Imports on an
+/// [ImportPool] therefore cannot run while a log stream is attached: [attach]
+/// fails while pool imports are queued or running, and imports submitted to
+/// a pool while a log stream is attached fail with a [StateError].
+///
+/// The same applies to other isolates. Do not run Assimp on any other
+/// isolate while a log stream is attached; this is not checked.
+class LogStream {
+  LogStream._(this._id, this._stream);
+
+  static final _streams = <int, LogStream>{};
+  static var _nextId = 0;
+  static var _verbose = false;
+  static final _callback =
+      Pointer.fromFunction<aiLogStreamCallback>(_onMessage);
+
+  final int _id;
+  final Pointer<aiLogStream> _stream;
+  final _messages = StreamController<LogMessage>.broadcast();
+  final _timings = StreamController<TimingEvent>.broadcast();
+  String? _step;
+
+  /// Whether any log stream is attached.
+  static bool get isAttached => _streams.isNotEmpty;
+
+  /// Attaches a new log stream to Assimp's logger.
+  ///
+  /// Enables [verbose] logging, which is required for debug messages and
+  /// profiler timings until the last log stream is detached. Throws a
+  /// [StateError] if an [ImportPool] has queued or running imports.
+  static LogStream attach({bool verbose = false}) {
+    if (ImportPool.active > 0) {
+      throw StateError('Cannot attach a LogStream while ImportPool is busy');
+    }
+    final id = ++_nextId;
+    final stream = calloc<aiLogStream>();
+    stream.ref.callback = _callback;
+    stream.ref.user = Pointer<Int8>.fromAddress(id);
+    final log = LogStream._(id, stream);
+    _streams[id] = log;
+    if (verbose) {
+      _verbose = true;
+      libassimp.aiEnableVerboseLogging(1);
+    }
+    libassimp.aiAttachLogStream(stream);
+    return log;
+  }
+
+  /// The log messages.
+  Stream<LogMessage> get messages => _messages.stream;
+
+  /// The profiler timings parsed from the log messages.
+  Stream<TimingEvent> get timings => _timings.stream;
+
+  /// Detaches this log stream and closes [messages] and [timings].
+  ///
+  /// Detaching the last log stream disables verbose logging again.
+  void detach() {
+    if (_streams.remove(_id) == null) return;
+    libassimp.aiDetachLogStream(_stream);
+    calloc.free(_stream);
+    _messages.close();
+    _timings.close();
+    if (_streams.isEmpty && _verbose) {
+      _verbose = false;
+      libassimp.aiEnableVerboseLogging(0);
+    }
+  }
+
+  static final _start = RegExp(r'^START `(.+)`');
+  static final _end = RegExp(r'^END\s+`(.+)`, dt= ([-+0-9.eE]+) s');
+  static final _begin = RegExp(r'^(\w+Process\w*) begin');
+
+  static void _onMessage(Pointer<Int8> message, Pointer<Int8> user) {
+    final log = _streams[user.address];
+    if (log == null) return;
+    log._add(LogMessage.parse(message.toDartString()));
+  }
+
+  void _add(LogMessage message) {
+    if (_messages.hasListener) _messages.add(message);
+    final text = message.text;
+    final begin = _begin.firstMatch(text);
+    if (begin != null) {
+      _step = begin.group(1);
+      return;
+    }
+    if (_start.hasMatch(text)) return;
+    final end = _end.firstMatch(text);
+    if (end == null) return;
+    final region = end.group(1)!;
+    final seconds = double.tryParse(end.group(2)!) ?? 0;
+    final step = region == 'postprocess' ? _step : null;
+    if (_timings.hasListener) {
+      _timings.add(TimingEvent(region,
+          Duration(microseconds: (seconds * 1e6).round()), step));
+    }
+  }
+}
@@ -0,0 +1,183 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'bindings.dart';
+import 'names.dart';
+import 'node.dart';
+import 'scene.dart';
+
+/// Name-indexed lookups between the nodes, bones and animation channels of
+/// a [Scene].
+///
+/// Bones and animation channels refer to nodes by name. The index resolves
+/// every name once, while interning it into [names], so that binding a
+/// skeleton or an animation to the hierarchy takes linear time instead of
+/// a hierarchy scan per bone or channel.
+///
+/// Nodes are indexed in depth-first preorder, the order of
+/// [FlatHierarchy] and [CachedScene.nodes]. Bones and channels whose name
+/// matches no node resolve to -1. If several nodes share a name, the first
+/// one in preorder wins.
+///
+/// The index only depends on names and topology. Setting
+/// [Node.transformation] does not affect it.
+class SceneIndex {
+  SceneIndex._(this.names, this._nodes, this.parents, this.nodeNameIds,
+      this._nodesByName, this.boneNodes, this.channelNodes);
+
+  /// Builds the index for [scene].
+  ///
+  /// Node names are interned first, then the names that only occur on
+  /// bones or channels, see [NameTable.fromScene].
+  factory SceneIndex.fromScene(Scene scene) {
+    final names = NameTable();
+    final native = scene.ptr.ref;
+
+    final nodes = <Pointer<aiNode>>[];
+    final parentList = <int>[];
+    final nameIdList = <int>[];
+    final stack = <Pointer<aiNode>>[native.mRootNode];
+    final parentStack = <int>[-1];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final parent = parentStack.removeLast();
+      if (node == nullptr) continue;
+      final index = nodes.length;
+      nodes.add(node);
+      parentList.add(parent);
+      // mName is the first member of aiNode.
+      nameIdList.add(names.internNative(node.cast()));
+      final children = node.ref.mChildren;
+      for (var i = node.ref.mNumChildren - 1; i >= 0; --i) {
+        stack.add(children[i]);
+        parentStack.add(index);
+      }
+    }
+    final nodeNameIds = Int32List.fromList(nameIdList);
+
+    final boneIds = List.generate(native.mNumMeshes, (i) {
+      final mesh = native.mMeshes[i].ref;
+      return Int32List.fromList(List.generate(mesh.mNumBones, (j) {
+        // mName is the first member of aiBone.
+        return names.internNative(mesh.mBones[j].cast());
+      }));
+    });
+    final channelIds = List.generate(native.mNumAnimations, (i) {
+      final animation = native.mAnimations[i].ref;
+      return Int32List.fromList(List.generate(animation.mNumChannels, (j) {
+        // mNodeName is the first member of aiNodeAnim.
+        return names.internNative(animation.mChannels[j].cast());
+      }));
+    });
+
+    final nodesByName = Int32List(names.length)..fillRange(0, names.length, -1);
+    for (var i = 0; i < nodeNameIds.length; ++i) {
+      final id = nodeNameIds[i];
+      if (nodesByName[id] < 0) nodesByName[id] = i;
+    }
+    Int32List resolve(Int32List ids) {
+      for (var i = 0; i < ids.length; ++i) {
+        ids[i] = nodesByName[ids[i]];
+      }
+      return ids;
+    }
+
+    return SceneIndex._(
+        names,
+        List.unmodifiable(nodes),
+        Int32List.fromList(parentList),
+        nodeNameIds,
+        nodesByName,
+        List.unmodifiable(boneIds.map(resolve)),
+        List.unmodifiable(channelIds.map(resolve)));
+  }
+
+  final List<Pointer<aiNode>> _nodes;
+  final Int32List _nodesByName;
+
+  /// The node, bone and channel names of the scene.
+  final NameTable names;
+
+  /// The index of the parent of each node, or -1 for the root.
+  final Int32List parents;
+
+  /// The [names] id of the name of each node.
+  final Int32List nodeNameIds;
+
+  /// The index of the node of each bone, by mesh and bone index.
+  final List<Int32List> boneNodes;
+
+  /// The index of the node animated by each channel, by animation and
+  /// channel index.
+  final List<Int32List> channelNodes;
+
+  /// The number of nodes.
+  int get length => _nodes.length;
+
+  /// The node at [index].
+  Node node(int index) => Node.fromNative(_nodes[index])!;
+
+  /// Returns the index of the first node called [name], or -1 if none.
+  int nodeIndexOf(String name) {
+    final id = names.idOf(name);
+    return id < 0 || id >= _nodesByName.length ? -1 : _nodesByName[id];
+  }
+
+  /// Returns the first node called [name], or null if none.
+  Node? nodeOf(String name) => _node(nodeIndexOf(name));
+
+  /// Returns the node of the bone at [bone] of the mesh at [mesh], or null
+  /// if no node has its name.
+  Node? boneNode(int mesh, int bone) => _node(boneNodes[mesh][bone]);
+
+  /// Returns the node animated by the channel at [channel] of the animation
+  /// at [animation], or null if no node has its name.
+  Node? channelNode(int animation, int channel) {
+    return _node(channelNodes[animation][channel]);
+  }
+
+  Node? _node(int index) => index < 0 ? null : node(index);
+}
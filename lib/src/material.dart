@@ -79,7 +79,10 @@ class MaterialProperty extends AssimpType<aiMaterialProperty> {
 
   /// Specifies the name of the property (key)
   /// Keys are generally case insensitive.
-  String get key => AssimpString.fromNative(_property.mKey);
+  String get key {
+    // mKey is the first member of aiMaterialProperty.
+    return AssimpString.fromPointer(ptr.cast());
+  }
 
   /// The value of the property
   dynamic get value {
@@ -89,7 +92,7 @@ class MaterialProperty extends AssimpType<aiMaterialProperty> {
       case aiPropertyTypeInfo.aiPTI_Double:
         return _property.mData.cast<Double>().value;
       case aiPropertyTypeInfo.aiPTI_String:
-        return AssimpString.fromNative(_property.mData.cast<aiString>().ref);
+        return AssimpString.fromPointer(_property.mData.cast());
       case aiPropertyTypeInfo.aiPTI_Integer:
         return _property.mData.cast<Uint32>().value;
       case aiPropertyTypeInfo.aiPTI_Buffer:
@@ -133,6 +136,27 @@ class Material extends AssimpType<aiMaterial> {
     );
   }
 
+  // Indices by aiMaterial address, shared by all wrappers of a material.
+  static final _indices = <int, MaterialIndex>{};
+
+  /// An index of the material properties for typed lookups.
+  ///
+  /// Built on first access and shared by all [Material] objects of the same
+  /// material, until the scene is post-processed or disposed.
+  MaterialIndex get index {
+    return _indices.putIfAbsent(ptr.address, () => MaterialIndex(this));
+  }
+
+  /// Drops the shared indices of the materials of [scene].
+  ///
+  /// @internal
+  static void release(Pointer<aiScene> scene) {
+    final native = scene.ref;
+    for (var i = 0; i < native.mNumMaterials; ++i) {
+      _indices.remove(native.mMaterials[i].address);
+    }
+  }
+
   /// Returns a list of material textures with [type]
   Iterable<String> textures(TextureType type) {
     return Iterable.generate(
@@ -141,7 +165,7 @@ class Material extends AssimpType<aiMaterial> {
         final str = calloc<aiString>();
         libassimp.aiGetMaterialTexture(ptr, type.index, i, str, nullptr,
             nullptr, nullptr, nullptr, nullptr, nullptr);
-        final path = AssimpString.fromNative(str.ref);
+        final path = AssimpString.fromPointer(str);
         calloc.free(str);
         return path;
       },
@@ -149,6 +173,312 @@ class Material extends AssimpType<aiMaterial> {
   }
 }
 
+/// Standard material property keys.
+///
+/// Texture properties are stored once per texture, with the [TextureType]
+/// as semantic and the texture number as index.
+class MaterialKey {
+  static const String name = '?mat.name';
+  static const String twoSided = '\$mat.twosided';
+  static const String shadingModel = '\$mat.shadingm';
+  static const String blendFunc = '\$mat.blend';
+  static const String opacity = '\$mat.opacity';
+  static const String transparencyFactor = '\$mat.transparencyfactor';
+  static const String shininess = '\$mat.shininess';
+  static const String shininessStrength = '\$mat.shinpercent';
+  static const String refraction = '\$mat.refracti';
+  static const String colorDiffuse = '\$clr.diffuse';
+  static const String colorAmbient = '\$clr.ambient';
+  static const String colorSpecular = '\$clr.specular';
+  static const String colorEmissive = '\$clr.emissive';
+  static const String colorTransparent = '\$clr.transparent';
+  static const String colorReflective = '\$clr.reflective';
+  static const String baseColor = '\$clr.base';
+  static const String metallicFactor = '\$mat.metallicFactor';
+  static const String roughnessFactor = '\$mat.roughnessFactor';
+  static const String emissiveIntensity = '\$mat.emissiveIntensity';
+  static const String textureFile = '\$tex.file';
+  static const String textureUvIndex = '\$tex.uvwsrc';
+  static const String textureMapping = '\$tex.mapping';
+  static const String textureBlend = '\$tex.blend';
+  static const String textureOp = '\$tex.op';
+  static const String textureMapModeU = '\$tex.mapmodeu';
+  static const String textureMapModeV = '\$tex.mapmodev';
+  static const String textureFlags = '\$tex.flags';
+}
+
+/// Defines how texture coordinates are generated for a texture.
+enum TextureMapping {
+  /// The mapping coordinates are taken from an UV channel.
+  uv,
+
+  /// Spherical mapping.
+  sphere,
+
+  /// Cylindrical mapping.
+  cylinder,
+
+  /// Cubic mapping.
+  box,
+
+  /// Planar mapping.
+  plane,
+
+  /// Undefined mapping.
+  other,
+}
+
+/// Defines how the n-th texture of a stack is combined with the result of
+/// the previous n-1 textures.
+enum TextureOp {
+  /// T = T1 * T2
+  multiply,
+
+  /// T = T1 + T2
+  add,
+
+  /// T = T1 - T2
+  subtract,
+
+  /// T = T1 / T2
+  divide,
+
+  /// T = (T1 + T2) - (T1 * T2)
+  smoothAdd,
+
+  /// T = T1 + (T2-0.5)
+  signedAdd,
+}
+
+/// Defines how UV coordinates outside the [0...1] range are handled.
+enum TextureMapMode {
+  /// A texture coordinate u|v is translated to u%1|v%1.
+  wrap,
+
+  /// Texture coordinates outside [0...1] are clamped to the nearest valid
+  /// value.
+  clamp,
+
+  /// A texture coordinate u|v becomes u%1|v%1 if (u-(u%1))%2 is zero and
+  /// 1-(u%1)|1-(v%1) otherwise.
+  mirror,
+
+  /// If the texture coordinates for a pixel are outside [0...1] the texture
+  /// is not applied to that pixel.
+  decal,
+}
+
+/// Defines some mixed flags for a particular texture.
+class TextureFlags {
+  /// The texture's color values have to be inverted (component-wise 1-n).
+  static const int invert = 0x1;
+
+  /// Explicit request to the application to process the alpha channel of
+  /// the texture.
+  static const int useAlpha = 0x2;
+
+  /// Explicit request to the application to ignore the alpha channel of
+  /// the texture.
+  static const int ignoreAlpha = 0x4;
+}
+
+/// A texture reference of a [Material], with all of its parameters.
+class MaterialTexture {
+  const MaterialTexture(
+    this.path, {
+    this.uvIndex = 0,
+    this.mapping = TextureMapping.uv,
+    this.blend = 1.0,
+    this.op,
+    this.mapModeU = TextureMapMode.wrap,
+    this.mapModeV = TextureMapMode.wrap,
+    this.flags = 0,
+  });
+
+  /// The path of the texture, or `*<index>` for embedded textures.
+  final String path;
+
+  /// The UV channel used by the texture.
+  final int uvIndex;
+
+  /// How texture coordinates are generated.
+  final TextureMapping mapping;
+
+  /// The blend factor of the texture.
+  final double blend;
+
+  /// How the texture is combined with the previous textures, if defined.
+  final TextureOp? op;
+
+  /// The wrap mode in U direction.
+  final TextureMapMode mapModeU;
+
+  /// The wrap mode in V direction.
+  final TextureMapMode mapModeV;
+
+  /// A combination of [TextureFlags].
+  final int flags;
+
+  @override
+  String toString() => 'MaterialTexture($path)';
+}
+
+class _PropertyEntry {
+  const _PropertyEntry(this.semantic, this.index, this.type, this.length,
+      this.data);
+  final int semantic;
+  final int index;
+  final int type;
+  final int length;
+  final Pointer<Uint8> data;
+}
+
+/// A lookup table over the properties of a [Material].
+///
+/// The table is built in a single pass over the native property array and
+/// answers typed queries by (key, semantic, index) without creating
+/// [MaterialProperty] wrappers or temporary native strings. Values are read
+/// from the material on each query, so the index is only valid as long as
+/// the material is alive.
+class MaterialIndex {
+  MaterialIndex(Material material) {
+    final native = material.ptr.ref;
+    for (var i = 0; i < native.mNumProperties; ++i) {
+      final property = native.mProperties[i].ref;
+      // mKey is the first member of aiMaterialProperty.
+      final key = AssimpString.fromPointer(native.mProperties[i].cast());
+      _entries.putIfAbsent(key, () => []).add(_PropertyEntry(
+          property.mSemantic,
+          property.mIndex,
+          property.mType,
+          property.mDataLength,
+          property.mData.cast<Uint8>()));
+    }
+  }
+
+  final _entries = <String, List<_PropertyEntry>>{};
+
+  /// The distinct property keys of the material.
+  Iterable<String> get keys => _entries.keys;
+
+  /// Whether the material has a property with the given [key], [semantic]
+  /// and [index].
+  bool contains(String key, [int semantic = 0, int index = 0]) {
+    return _find(key, semantic, index) != null;
+  }
+
+  /// Returns a floating point property, converting integers if necessary.
+  double? getFloat(String key, [int semantic = 0, int index = 0]) {
+    final entry = _find(key, semantic, index);
+    if (entry == null || entry.length < 4) return null;
+    return _real(entry, 0);
+  }
+
+  /// Returns an integer property, truncating floating point values.
+  int? getInt(String key, [int semantic = 0, int index = 0]) {
+    final entry = _find(key, semantic, index);
+    if (entry == null || entry.length < 4) return null;
+    switch (entry.type) {
+      case aiPropertyTypeInfo.aiPTI_Float:
+      case aiPropertyTypeInfo.aiPTI_Double:
+        return _real(entry, 0).toInt();
+      case aiPropertyTypeInfo.aiPTI_String:
+        return null;
+      default:
+        return entry.data.cast<Int32>().value;
+    }
+  }
+
+  /// Returns a color property as (r, g, b, a).
+  ///
+  /// Alpha defaults to 1.0 for RGB colors. Note that the components are in
+  /// a different order than in [AssimpColor4.fromNative].
+  Vector4? getColorRgba(String key, [int semantic = 0, int index = 0]) {
+    final entry = _find(key, semantic, index);
+    if (entry == null) return null;
+    final count = entry.length ~/ _realSize(entry);
+    if (count < 3 || entry.type == aiPropertyTypeInfo.aiPTI_String) {
+      return null;
+    }
+    return Vector4(_real(entry, 0), _real(entry, 1), _real(entry, 2),
+        count > 3 ? _real(entry, 3) : 1.0);
+  }
+
+  /// Returns a string property.
+  String? getString(String key, [int semantic = 0, int index = 0]) {
+    final entry = _find(key, semantic, index);
+    if (entry == null || entry.type != aiPropertyTypeInfo.aiPTI_String) {
+      return null;
+    }
+    return AssimpString.fromPointer(entry.data.cast());
+  }
+
+  /// Returns the number of textures of the given [type].
+  int textureCount(TextureType type) {
+    final entries = _entries[MaterialKey.textureFile];
+    if (entries == null) return 0;
+    var count = 0;
+    for (final entry in entries) {
+      if (entry.semantic == type.index) ++count;
+    }
+    return count;
+  }
+
+  /// Returns the [index]th texture of the given [type] with all of its
+  /// parameters, or `null` if there is no such texture.
+  MaterialTexture? getTexture(TextureType type, [int index = 0]) {
+    final semantic = type.index;
+    final path = getString(MaterialKey.textureFile, semantic, index);
+    if (path == null) return null;
+    final op = getInt(MaterialKey.textureOp, semantic, index);
+    return MaterialTexture(
+      path,
+      uvIndex: getInt(MaterialKey.textureUvIndex, semantic, index) ?? 0,
+      mapping: _enum(TextureMapping.values,
+              getInt(MaterialKey.textureMapping, semantic, index)) ??
+          TextureMapping.uv,
+      blend: getFloat(MaterialKey.textureBlend, semantic, index) ?? 1.0,
+      op: _enum(TextureOp.values, op),
+      mapModeU: _enum(TextureMapMode.values,
+              getInt(MaterialKey.textureMapModeU, semantic, index)) ??
+          TextureMapMode.wrap,
+      mapModeV: _enum(TextureMapMode.values,
+              getInt(MaterialKey.textureMapModeV, semantic, index)) ??
+          TextureMapMode.wrap,
+      flags: getInt(MaterialKey.textureFlags, semantic, index) ?? 0,
+    );
+  }
+
+  _PropertyEntry? _find(String key, int semantic, int index) {
+    final entries = _entries[key];
+    if (entries == null) return null;
+    for (final entry in entries) {
+      if (entry.semantic == semantic && entry.index == index) return entry;
+    }
+    return null;
+  }
+
+  static T? _enum<T>(List<T> values, int? value) {
+    if (value == null || value < 0 || value >= values.length) return null;
+    return values[value];
+  }
+
+  static int _realSize(_PropertyEntry entry) {
+    return entry.type == aiPropertyTypeInfo.aiPTI_Double ? 8 : 4;
+  }
+
+  static double _real(_PropertyEntry entry, int i) {
+    switch (entry.type) {
+      case aiPropertyTypeInfo.aiPTI_Double:
+        return entry.data.cast<Double>()[i];
+      case aiPropertyTypeInfo.aiPTI_Integer:
+        return entry.data.cast<Int32>()[i].toDouble();
+      default:
+        return entry.data.cast<Float>()[i];
+    }
+  }
+}
+
 /// Defines the purpose of a texture
 ///
 /// This is a very difficult topic. Different 3D packages support different
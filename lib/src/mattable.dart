@@ -0,0 +1,234 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:typed_data';
+
+import 'filesystem.dart';
+import 'hash.dart';
+import 'material.dart';
+import 'scene.dart';
+
+/// Texture slots of a [MaterialTable] entry, in the order in which their
+/// texture ids are stored.
+const List<TextureType> materialTableTextures = [
+  TextureType.baseColor,
+  TextureType.normals,
+  TextureType.emissive,
+  TextureType.metalness,
+  TextureType.diffuseRoughness,
+  TextureType.ambientOcclusion,
+  TextureType.specular,
+  TextureType.opacity,
+];
+
+/// The materials of a scene, deduplicated and packed into fixed-layout
+/// structs for a GPU uniform or storage buffer.
+///
+/// Each entry is [stride] bytes, 16-byte aligned for std140 and std430:
+///
+/// | offset | type     | contents                                        |
+/// |--------|----------|-------------------------------------------------|
+/// | 0      | vec4     | base color (rgba)                               |
+/// | 16     | vec4     | emissive color (rgb), emissive intensity        |
+/// | 32     | vec4     | specular color (rgb), shininess                 |
+/// | 48     | float x3 | metallic, roughness, opacity                    |
+/// | 60     | uint     | [twoSidedFlag], [transparentFlag]               |
+/// | 64     | int x8   | ids into [textures] for [materialTableTextures] |
+///
+/// Values are little endian. Missing texture slots are -1.
+///
+/// Properties are normalized before comparison: the base color falls back
+/// to the diffuse color, base color textures to diffuse textures, missing
+/// factors take their glTF defaults, and texture paths are normalized with
+/// [FileSystem.normalize]. Materials that only differ in their name or in
+/// properties outside of the layout share an entry.
+class MaterialTable {
+  MaterialTable._(this.data, this.textures, this.materialRemap,
+      this.meshMaterials);
+
+  /// The size of an entry in bytes.
+  static const int stride = 96;
+
+  /// Set in the flags of double-sided materials.
+  static const int twoSidedFlag = 0x1;
+
+  /// Set in the flags of materials with an opacity below one or an opacity
+  /// texture.
+  static const int transparentFlag = 0x2;
+
+  /// Builds the table for the materials and meshes of [scene].
+  factory MaterialTable.fromScene(Scene scene) {
+    final materials = scene.materials.toList();
+    final builder = BytesBuilder(copy: false);
+    final textures = <String>[];
+    final textureIds = <String, int>{};
+    final entries = <int, List<int>>{};
+    final packed = <Uint8List>[];
+    final materialRemap = Uint32List(materials.length);
+    final entry = ByteData(stride);
+    final entryBytes = entry.buffer.asUint8List();
+
+    for (var i = 0; i < materials.length; ++i) {
+      _pack(materials[i].index, entry, (path) {
+        final normalized = FileSystem.normalize(path);
+        return textureIds.putIfAbsent(normalized, () {
+          textures.add(normalized);
+          return textures.length - 1;
+        });
+      });
+      final hash = fnv1a64(entryBytes);
+      final candidates = entries.putIfAbsent(hash, () => []);
+      var id = -1;
+      for (final candidate in candidates) {
+        if (_equals(packed[candidate], entryBytes)) {
+          id = candidate;
+          break;
+        }
+      }
+      if (id < 0) {
+        id = packed.length;
+        final copy = Uint8List.fromList(entryBytes);
+        packed.add(copy);
+        candidates.add(id);
+        builder.add(copy);
+      }
+      materialRemap[i] = id;
+    }
+
+    final meshes = scene.meshes;
+    final meshMaterials = Uint32List(meshes.length);
+    var m = 0;
+    for (final mesh in meshes) {
+      final index = mesh.materialIndex;
+      meshMaterials[m++] = index < materialRemap.length
+          ? materialRemap[index]
+          : 0;
+    }
+
+    return MaterialTable._(ByteData.sublistView(builder.takeBytes()),
+        textures, materialRemap, meshMaterials);
+  }
+
+  /// The packed entries, [length] times [stride] bytes.
+  final ByteData data;
+
+  /// The distinct, normalized texture paths referenced by the entries.
+  final List<String> textures;
+
+  /// The entry of each scene material.
+  final Uint32List materialRemap;
+
+  /// The entry of each scene mesh.
+  final Uint32List meshMaterials;
+
+  /// The number of distinct entries.
+  int get length => data.lengthInBytes ~/ stride;
+
+  /// Returns the texture id of [slot] in [entry], or -1 if the slot is
+  /// empty.
+  int textureId(int entry, TextureType slot) {
+    final i = materialTableTextures.indexOf(slot);
+    if (i < 0) return -1;
+    return data.getInt32(entry * stride + 64 + i * 4, Endian.little);
+  }
+
+  static void _pack(
+      MaterialIndex index, ByteData out, int Function(String path) texture) {
+    final base = index.getColorRgba(MaterialKey.baseColor) ??
+        index.getColorRgba(MaterialKey.colorDiffuse);
+    final opacity = index.getFloat(MaterialKey.opacity) ?? 1.0;
+    _putColor(out, 0, base?.x ?? 1.0, base?.y ?? 1.0, base?.z ?? 1.0,
+        base?.w ?? 1.0);
+
+    final emissive = index.getColorRgba(MaterialKey.colorEmissive);
+    final intensity = index.getFloat(MaterialKey.emissiveIntensity) ?? 1.0;
+    _putColor(out, 16, emissive?.x ?? 0.0, emissive?.y ?? 0.0,
+        emissive?.z ?? 0.0, intensity);
+
+    final specular = index.getColorRgba(MaterialKey.colorSpecular);
+    final shininess = index.getFloat(MaterialKey.shininess) ?? 0.0;
+    _putColor(out, 32, specular?.x ?? 0.0, specular?.y ?? 0.0,
+        specular?.z ?? 0.0, shininess);
+
+    final metallic = index.getFloat(MaterialKey.metallicFactor) ?? 1.0;
+    final roughness = index.getFloat(MaterialKey.roughnessFactor) ?? 1.0;
+    out.setFloat32(48, _canonical(metallic), Endian.little);
+    out.setFloat32(52, _canonical(roughness), Endian.little);
+    out.setFloat32(56, _canonical(opacity), Endian.little);
+
+    var flags = 0;
+    if ((index.getInt(MaterialKey.twoSided) ?? 0) != 0) flags |= twoSidedFlag;
+    if (opacity < 1.0 || index.textureCount(TextureType.opacity) > 0) {
+      flags |= transparentFlag;
+    }
+    out.setUint32(60, flags, Endian.little);
+
+    for (var i = 0; i < materialTableTextures.length; ++i) {
+      final type = materialTableTextures[i];
+      var path = index.getTexture(type)?.path;
+      if (path == null && type == TextureType.baseColor) {
+        path = index.getTexture(TextureType.diffuse)?.path;
+      }
+      out.setInt32(
+          64 + i * 4, path == null ? -1 : texture(path), Endian.little);
+    }
+  }
+
+  static void _putColor(
+      ByteData out, int offset, double r, double g, double b, double a) {
+    out.setFloat32(offset, _canonical(r), Endian.little);
+    out.setFloat32(offset + 4, _canonical(g), Endian.little);
+    out.setFloat32(offset + 8, _canonical(b), Endian.little);
+    out.setFloat32(offset + 12, _canonical(a), Endian.little);
+  }
+
+  // Folds -0.0 into 0.0 so that the byte comparison matches the values.
+  static double _canonical(double value) => value == 0.0 ? 0.0 : value;
+
+  static bool _equals(Uint8List a, Uint8List b) {
+    for (var i = 0; i < a.length; ++i) {
+      if (a[i] != b[i]) return false;
+    }
+    return true;
+  }
+}
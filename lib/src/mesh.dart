@@ -119,7 +119,10 @@ class Bone extends AssimpType<aiBone> {
   }
 
   /// The name of the bone.
-  String get name => AssimpString.fromNative(_bone.mName);
+  String get name {
+    // mName is the first member of aiBone.
+    return AssimpString.fromPointer(ptr.cast());
+  }
 
   /// The influence weights of this bone, by vertex index.
   Iterable<VertexWeight> get weights {
@@ -142,6 +145,62 @@ class Bone extends AssimpType<aiBone> {
   Matrix4 get offset => AssimpMatrix4.fromNative(_bone.mOffsetMatrix);
 }
 
+/// Per-vertex skinning data of a [Mesh], see [Mesh.skinData].
+class SkinData {
+  /// The number of influences per vertex.
+  final int influences;
+
+  /// The bone indices, [influences] per vertex, ordered by descending
+  /// weight. Unused slots are 0.
+  final Uint16List joints;
+
+  /// The bone weights matching [joints], normalized to sum up to 1 for
+  /// each skinned vertex. Unused slots are 0.
+  final Float32List weights;
+
+  SkinData._(aiMesh mesh, this.influences)
+      : joints = Uint16List(mesh.mNumVertices * influences),
+        weights = Float32List(mesh.mNumVertices * influences) {
+    for (var b = 0; b < mesh.mNumBones; ++b) {
+      final bone = mesh.mBones[b].ref;
+      final n = bone.mNumWeights;
+      // aiVertexWeight is {unsigned int mVertexId; float mWeight;}
+      final ids = bone.mWeights.cast<Uint32>().asTypedList(n * 2);
+      final values = bone.mWeights.cast<Float>().asTypedList(n * 2);
+      for (var i = 0; i < n; ++i) {
+        _insert(ids[i * 2], b, values[i * 2 + 1]);
+      }
+    }
+    for (var v = 0; v < weights.length; v += influences) {
+      var sum = 0.0;
+      for (var i = 0; i < influences; ++i) {
+        sum += weights[v + i];
+      }
+      if (sum <= 0) continue;
+      for (var i = 0; i < influences; ++i) {
+        weights[v + i] /= sum;
+      }
+    }
+  }
+
+  // Keeps the slots of a vertex sorted by descending weight.
+  void _insert(int vertex, int joint, double weight) {
+    final base = vertex * influences;
+    if (base >= weights.length) return;
+    var slot = influences;
+    while (slot > 0 && weights[base + slot - 1] < weight) {
+      --slot;
+    }
+    if (slot == influences) return;
+    for (var i = influences - 1; i > slot; --i) {
+      weights[base + i] = weights[base + i - 1];
+      joints[base + i] = joints[base + i - 1];
+    }
+    weights[base + slot] = weight;
+    joints[base + slot] = joint;
+  }
+}
+
 /// The types of geometric primitives supported by Assimp.
 ///
 /// See also:
@@ -306,6 +365,15 @@ class Mesh extends AssimpType<aiMesh> {
     );
   }
 
+  /// A view of the vertex colors in the given color [set], as packed RGBA
+  /// floats. Returns `null` if the set is not present.
+  Float32List? colorData(int set) {
+    if (set < 0 || set >= AI_MAX_NUMBER_OF_COLOR_SETS) return null;
+    final colors = _mesh.mColors[set];
+    if (AssimpPointer.isNull(colors)) return null;
+    return colors.cast<Float>().asTypedList(_mesh.mNumVertices * 4);
+  }
+
   /// Vertex texture coords, also known as UV channels.
   /// A mesh may contain 0 to AI_MAX_NUMBER_OF_TEXTURECOORDS per
   /// vertex. NULL if not present. The array is mNumVertices in size.
@@ -325,6 +393,28 @@ class Mesh extends AssimpType<aiMesh> {
     );
   }
 
+  /// The texture coordinates in the given UV [channel], tightly packed with
+  /// as many floats per vertex as the channel has [uvComponents]. Returns
+  /// `null` if the channel is not present.
+  ///
+  /// Three-component channels are returned as a view of the native data,
+  /// other channels are packed into a new list.
+  Float32List? textureCoordData(int channel) {
+    if (channel < 0 || channel >= AI_MAX_NUMBER_OF_TEXTURECOORDS) return null;
+    final coords = _mesh.mTextureCoords[channel];
+    if (AssimpPointer.isNull(coords)) return null;
+    final count = _mesh.mNumVertices;
+    final source = coords.cast<Float>().asTypedList(count * 3);
+    final components = _mesh.mNumUVComponents[channel];
+    if (components >= 3) return source;
+    final packed = Float32List(count * components);
+    for (var i = 0, j = 0; i < packed.length; j += 3) {
+      packed[i++] = source[j];
+      if (components == 2) packed[i++] = source[j + 1];
+    }
+    return packed;
+  }
+
   /// Specifies the number of components for a given UV channel.
   /// Up to three channels are supported (UVW, for accessing volume
   /// or cube maps). If the value is 2 for a given channel n, the
@@ -352,6 +442,54 @@ class Mesh extends AssimpType<aiMesh> {
     );
   }
 
+  /// The indices of all faces, concatenated into a single list.
+  ///
+  /// For a triangulated mesh (see [ProcessFlags.triangulate]), this is a
+  /// ready-to-use triangle list with three indices per face.
+  Uint32List get indexData => _indexData(false);
+
+  /// The indices of the triangles of this mesh, three per triangle.
+  ///
+  /// Point and line faces, which triangulation keeps, are skipped, so a
+  /// mesh with mixed [primitiveTypes] yields its triangles only. Throws an
+  /// [ArgumentError] if the mesh has polygons with more than three
+  /// vertices; see [ProcessFlags.triangulate].
+  Uint32List get triangleIndexData => _indexData(
+      _mesh.mPrimitiveTypes != aiPrimitiveType.aiPrimitiveType_TRIANGLE);
+
+  Uint32List _indexData(bool trianglesOnly) {
+    final count = _mesh.mNumFaces;
+    if (count == 0) return Uint32List(0);
+    final faces = _mesh.mFaces;
+    // aiFace is {unsigned int mNumIndices; unsigned int *mIndices;}, read
+    // directly to avoid a struct wrapper per face
+    final size = sizeOf<aiFace>();
+    final wordStride = size ~/ 4;
+    final pointerStride = size ~/ sizeOf<IntPtr>();
+    final words = faces.cast<Uint32>().asTypedList(count * wordStride);
+    final pointers = sizeOf<IntPtr>() == 8
+        ? faces.cast<Uint64>().asTypedList(count * pointerStride)
+        : words;
+    var total = 0;
+    for (var i = 0; i < count; ++i) {
+      final n = words[i * wordStride];
+      if (trianglesOnly && n > 3) {
+        throw ArgumentError('Mesh has polygons, triangulate it first');
+      }
+      if (!trianglesOnly || n == 3) total += n;
+    }
+    final data = Uint32List(total);
+    for (var i = 0, k = 0; i < count; ++i) {
+      final n = words[i * wordStride];
+      if (n == 0 || (trianglesOnly && n != 3)) continue;
+      final address = pointers[i * pointerStride + 1];
+      final face = Pointer<Uint32>.fromAddress(address).asTypedList(n);
+      data.setRange(k, k + n, face);
+      k += n;
+    }
+    return data;
+  }
+
   /// The bones of this mesh.
   /// A bone consists of a name by which it can be found in the
   /// frame hierarchy and a set of vertex weights.
@@ -362,6 +500,31 @@ class Mesh extends AssimpType<aiMesh> {
     );
   }
 
+  /// The strongest [maxInfluences] bone influences of each vertex.
+  ///
+  /// Inverts the per-bone weights into per-vertex joint indices (into
+  /// [bones]) and normalized weights in a single pass over the native
+  /// weight arrays.
+  SkinData skinData({int maxInfluences = 4}) {
+    assert(maxInfluences > 0);
+    return SkinData._(_mesh, maxInfluences);
+  }
+
+  /// The offset matrices of all [bones], packed as 16 floats each in
+  /// column-major order, ready to upload as a GPU matrix array.
+  ///
+  /// Each matrix is the native row-major aiMatrix4x4 written column by
+  /// column, see [AssimpMatrix4.copyIntoStorage]. [Bone.offset] returns the
+  /// transpose of the native matrix, so the packed floats equal
+  /// `bone.offset.transposed().storage`, not `bone.offset.storage`.
+  Float32List get boneOffsetData {
+    final data = Float32List(_mesh.mNumBones * 16);
+    for (var b = 0; b < _mesh.mNumBones; ++b) {
+      _mesh.mBones[b].ref.mOffsetMatrix.copyIntoStorage(data, b * 16);
+    }
+    return data;
+  }
+
   /// The material used by this mesh.
   /// A mesh uses only a single material. If an imported model uses
   /// multiple materials, the import splits up the mesh. Use this value
@@ -0,0 +1,654 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'mesh.dart';
+
+/// Vertex cache efficiency of a triangle list.
+class VertexCacheStats {
+  const VertexCacheStats(this.acmr, this.atvr);
+
+  /// The average cache miss ratio: vertex shader invocations per triangle.
+  ///
+  /// Ranges from 3 (no reuse) down to about 0.5 for regular grids.
+  final double acmr;
+
+  /// The average transformed vertex ratio: vertex shader invocations per
+  /// vertex. 1.0 is optimal.
+  final double atvr;
+
+  @override
+  String toString() => 'VertexCacheStats(acmr: ${acmr.toStringAsFixed(3)}, '
+      'atvr: ${atvr.toStringAsFixed(3)})';
+}
+
+/// Meshlets of a triangle list, for mesh shaders or cluster culling.
+///
+/// Meshlet `i` is described by four entries of [meshlets]: the offset into
+/// [vertices], the offset into [triangles], the vertex count and the
+/// triangle count. [vertices] maps the meshlet-local vertex indices to
+/// mesh vertices, and [triangles] holds three local indices per triangle.
+///
+/// [bounds] holds 12 floats per meshlet: the bounding sphere center and
+/// radius, then the normal cone apex, axis and cutoff, and one float of
+/// padding. A meshlet is entirely backfacing and can be culled if
+/// `dot(normalize(apex - cameraPosition), axis) >= cutoff`. The cutoff is
+/// 1.0 for meshlets whose normals spread too far for a useful cone.
+class Meshlets {
+  Meshlets._(this.meshlets, this.vertices, this.triangles, this.bounds);
+
+  /// Offsets and counts, four per meshlet.
+  final Uint32List meshlets;
+
+  /// Mesh vertex indices of the meshlet vertices.
+  final Uint32List vertices;
+
+  /// Local vertex indices, three per triangle.
+  final Uint8List triangles;
+
+  /// Bounding spheres and normal cones, twelve floats per meshlet.
+  final Float32List bounds;
+
+  /// The number of meshlets.
+  int get length => meshlets.length ~/ 4;
+}
+
+/// The result of [MeshOptimize.optimize].
+class OptimizedMesh {
+  const OptimizedMesh(this.indices, this.remap, this.vertexCount, this.before,
+      this.after);
+
+  /// The reordered triangle list, indexing the remapped vertices.
+  final Uint32List indices;
+
+  /// The new index of each source vertex, or [MeshOptimizer.unused] for
+  /// vertices that are not referenced. Apply with
+  /// [MeshOptimizer.remapVertices].
+  final Uint32List remap;
+
+  /// The number of referenced vertices.
+  final int vertexCount;
+
+  /// The vertex cache efficiency of the source triangle list.
+  final VertexCacheStats before;
+
+  /// The vertex cache efficiency of [indices].
+  final VertexCacheStats after;
+}
+
+/// Reorders triangle lists for the GPU pipeline.
+///
+/// All functions work on triangle lists, three indices per triangle, into
+/// vertex buffers of the given vertex count, and run in linear or
+/// O(n log n) time.
+class MeshOptimizer {
+  /// Marks unreferenced vertices in vertex remap tables.
+  static const int unused = 0xffffffff;
+
+  /// Simulates a FIFO post-transform cache of [cacheSize] entries over
+  /// [indices].
+  static VertexCacheStats analyzeVertexCache(
+      Uint32List indices, int vertexCount,
+      {int cacheSize = 16}) {
+    final triangles = indices.length ~/ 3;
+    if (triangles == 0 || vertexCount == 0) {
+      return const VertexCacheStats(0, 0);
+    }
+    final timestamps = Int32List(vertexCount);
+    var time = cacheSize + 1;
+    var misses = 0;
+    for (var i = 0; i < triangles * 3; ++i) {
+      final v = indices[i];
+      if (time - timestamps[v] > cacheSize) {
+        timestamps[v] = time++;
+        ++misses;
+      }
+    }
+    return VertexCacheStats(misses / triangles, misses / vertexCount);
+  }
+
+  /// Reorders triangles to reduce vertex cache misses, using Tom
+  /// Forsyth's linear-speed vertex cache optimization.
+  static Uint32List optimizeVertexCache(Uint32List indices, int vertexCount,
+      {int cacheSize = 32}) {
+    final triangleCount = indices.length ~/ 3;
+    final result = Uint32List(triangleCount * 3);
+    if (triangleCount == 0) return result;
+
+    final adjacency = _Adjacency(indices, vertexCount);
+    final remaining = Uint32List.fromList(adjacency.counts);
+    final cachePosition = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+    final vertexScores = Float64List(vertexCount);
+    final triangleScores = Float64List(triangleCount);
+    final emitted = Uint8List(triangleCount);
+
+    double score(int v) {
+      final count = remaining[v];
+      if (count == 0) return -1;
+      final position = cachePosition[v];
+      var score = 0.0;
+      if (position >= 0) {
+        score = position < 3
+            ? 0.75
+            : math.pow(1 - (position - 3) / (cacheSize - 3), 1.5).toDouble();
+      }
+      return score + 2 * math.pow(count, -0.5);
+    }
+
+    for (var v = 0; v < vertexCount; ++v) {
+      vertexScores[v] = score(v);
+    }
+    for (var t = 0; t < triangleCount; ++t) {
+      triangleScores[t] = vertexScores[indices[t * 3]] +
+          vertexScores[indices[t * 3 + 1]] +
+          vertexScores[indices[t * 3 + 2]];
+    }
+
+    var cache = <int>[];
+    var next = <int>[];
+    var cursor = 0;
+    var best = -1;
+    for (var output = 0; output < triangleCount; ++output) {
+      if (best < 0) {
+        // no candidate next to the cache; take the next triangle in order
+        while (emitted[cursor] != 0) {
+          ++cursor;
+        }
+        best = cursor;
+      }
+      emitted[best] = 1;
+      final a = indices[best * 3], b = indices[best * 3 + 1];
+      final c = indices[best * 3 + 2];
+      result[output * 3] = a;
+      result[output * 3 + 1] = b;
+      result[output * 3 + 2] = c;
+
+      // move the vertices of the triangle to the front of the cache
+      next
+        ..clear()
+        ..add(a);
+      if (b != a) next.add(b);
+      if (c != a && c != b) next.add(c);
+      for (final v in cache) {
+        if (v != a && v != b && v != c) next.add(v);
+      }
+      for (final v in [a, b, c]) {
+        --remaining[v];
+        adjacency.remove(v, best);
+      }
+      final swap = cache;
+      cache = next;
+      next = swap;
+      for (var i = cacheSize; i < cache.length; ++i) {
+        cachePosition[cache[i]] = -1;
+      }
+
+      // rescore the triangles around the vertices in the cache
+      for (var i = 0; i < cache.length; ++i) {
+        final v = cache[i];
+        if (i < cacheSize) cachePosition[v] = i;
+        final updated = score(v);
+        final delta = updated - vertexScores[v];
+        vertexScores[v] = updated;
+        for (var k = adjacency.offsets[v]; k < adjacency.ends[v]; ++k) {
+          triangleScores[adjacency.triangles[k]] += delta;
+        }
+      }
+      if (cache.length > cacheSize) cache.length = cacheSize;
+
+      best = -1;
+      var bestScore = 0.0;
+      for (final v in cache) {
+        for (var k = adjacency.offsets[v]; k < adjacency.ends[v]; ++k) {
+          final t = adjacency.triangles[k];
+          if (triangleScores[t] > bestScore) {
+            bestScore = triangleScores[t];
+            best = t;
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  /// Reorders clusters of triangles to reduce overdraw, while keeping the
+  /// vertex cache miss ratio within [threshold] times that of [indices].
+  ///
+  /// [indices] should already be optimized for the vertex cache. The
+  /// triangle list is split into clusters where the cache is flushed, and
+  /// clusters facing away from the center of the mesh are drawn first, so
+  /// they occlude the rest.
+  static Uint32List optimizeOverdraw(
+      Uint32List indices, Float32List positions,
+      {double threshold = 1.05, int cacheSize = 16}) {
+    final vertexCount = positions.length ~/ 3;
+    final triangleCount = indices.length ~/ 3;
+    if (triangleCount == 0) return Uint32List(0);
+    final limit =
+        analyzeVertexCache(indices, vertexCount, cacheSize: cacheSize).acmr *
+            threshold;
+
+    // cluster starts, where all three vertices of a triangle miss the cache
+    final starts = <int>[0];
+    final timestamps = Int32List(vertexCount);
+    var time = cacheSize + 1;
+    for (var t = 0; t < triangleCount; ++t) {
+      var misses = 0;
+      for (var k = 0; k < 3; ++k) {
+        final v = indices[t * 3 + k];
+        if (time - timestamps[v] > cacheSize) {
+          timestamps[v] = time++;
+          ++misses;
+        }
+      }
+      if (misses == 3 && t > starts.last) starts.add(t);
+    }
+
+    var cx = 0.0, cy = 0.0, cz = 0.0;
+    for (var i = 0; i < indices.length; ++i) {
+      cx += positions[indices[i] * 3];
+      cy += positions[indices[i] * 3 + 1];
+      cz += positions[indices[i] * 3 + 2];
+    }
+    cx /= indices.length;
+    cy /= indices.length;
+    cz /= indices.length;
+
+    // merge clusters until the cache efficiency is acceptable
+    for (var merge = 1; ; merge *= 2) {
+      final clusters = <int>[
+        for (var i = 0; i < starts.length; i += merge) starts[i]
+      ];
+      if (clusters.length <= 1) return Uint32List.fromList(indices);
+      final keys = Float64List(clusters.length);
+      for (var c = 0; c < clusters.length; ++c) {
+        final end = c + 1 < clusters.length ? clusters[c + 1] : triangleCount;
+        var ax = 0.0, ay = 0.0, az = 0.0;
+        var nx = 0.0, ny = 0.0, nz = 0.0;
+        var area = 0.0;
+        for (var t = clusters[c]; t < end; ++t) {
+          final a = indices[t * 3] * 3, b = indices[t * 3 + 1] * 3;
+          final d = indices[t * 3 + 2] * 3;
+          final e1x = positions[b] - positions[a];
+          final e1y = positions[b + 1] - positions[a + 1];
+          final e1z = positions[b + 2] - positions[a + 2];
+          final e2x = positions[d] - positions[a];
+          final e2y = positions[d + 1] - positions[a + 1];
+          final e2z = positions[d + 2] - positions[a + 2];
+          final x = e1y * e2z - e1z * e2y;
+          final y = e1z * e2x - e1x * e2z;
+          final z = e1x * e2y - e1y * e2x;
+          final w = math.sqrt(x * x + y * y + z * z);
+          nx += x;
+          ny += y;
+          nz += z;
+          ax += (positions[a] + positions[b] + positions[d]) / 3 * w;
+          ay += (positions[a + 1] + positions[b + 1] + positions[d + 1]) /
+              3 *
+              w;
+          az += (positions[a + 2] + positions[b + 2] + positions[d + 2]) /
+              3 *
+              w;
+          area += w;
+        }
+        if (area == 0) continue;
+        final length = math.sqrt(nx * nx + ny * ny + nz * nz);
+        if (length == 0) continue;
+        keys[c] = ((ax / area - cx) * nx +
+                (ay / area - cy) * ny +
+                (az / area - cz) * nz) /
+            length;
+      }
+      final order = List<int>.generate(clusters.length, (i) => i)
+        ..sort((a, b) => keys[b].compareTo(keys[a]));
+      final result = Uint32List(indices.length);
+      var o = 0;
+      for (final c in order) {
+        final end = c + 1 < clusters.length ? clusters[c + 1] : triangleCount;
+        result.setRange(o, o + (end - clusters[c]) * 3, indices,
+            clusters[c] * 3);
+        o += (end - clusters[c]) * 3;
+      }
+      final acmr =
+          analyzeVertexCache(result, vertexCount, cacheSize: cacheSize).acmr;
+      if (acmr <= limit) return result;
+    }
+  }
+
+  /// Returns a vertex remap table that orders vertices by their first use
+  /// in [indices], to improve vertex fetch locality.
+  ///
+  /// Unreferenced vertices are mapped to [unused].
+  static Uint32List optimizeVertexFetchRemap(
+      Uint32List indices, int vertexCount) {
+    final remap = Uint32List(vertexCount)..fillRange(0, vertexCount, unused);
+    var next = 0;
+    for (var i = 0; i < indices.length; ++i) {
+      final v = indices[i];
+      if (remap[v] == unused) remap[v] = next++;
+    }
+    return remap;
+  }
+
+  /// Applies a vertex [remap] table to [indices].
+  static Uint32List remapIndices(Uint32List indices, Uint32List remap) {
+    final result = Uint32List(indices.length);
+    for (var i = 0; i < indices.length; ++i) {
+      result[i] = remap[indices[i]];
+    }
+    return result;
+  }
+
+  /// Applies a vertex [remap] table to a vertex stream with [components]
+  /// floats per vertex.
+  static Float32List remapVertices(
+      Float32List data, int components, Uint32List remap) {
+    var count = 0;
+    for (var v = 0; v < remap.length; ++v) {
+      if (remap[v] != unused) count = math.max(count, remap[v] + 1);
+    }
+    final result = Float32List(count * components);
+    for (var v = 0; v < remap.length; ++v) {
+      final target = remap[v];
+      if (target == unused) continue;
+      result.setRange(target * components, (target + 1) * components, data,
+          v * components);
+    }
+    return result;
+  }
+
+  /// Splits [indices] into meshlets of at most [maxVertices] vertices and
+  /// [maxTriangles] triangles, in triangle order.
+  ///
+  /// Run [optimizeVertexCache] first for tightly packed meshlets.
+  /// [maxVertices] may be at most 256, as local indices are bytes.
+  static Meshlets buildMeshlets(Uint32List indices, Float32List positions,
+      {int maxVertices = 64, int maxTriangles = 124}) {
+    assert(maxVertices >= 3 && maxVertices <= 256);
+    assert(maxTriangles >= 1);
+    final vertexCount = positions.length ~/ 3;
+    final local = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+    final meshlets = <int>[];
+    final vertices = <int>[];
+    final triangles = <int>[];
+    var vertexStart = 0, triangleStart = 0;
+
+    void flush() {
+      if (triangles.length == triangleStart) return;
+      meshlets.addAll([
+        vertexStart,
+        triangleStart ~/ 3,
+        vertices.length - vertexStart,
+        (triangles.length - triangleStart) ~/ 3,
+      ]);
+      for (var i = vertexStart; i < vertices.length; ++i) {
+        local[vertices[i]] = -1;
+      }
+      vertexStart = vertices.length;
+      triangleStart = triangles.length;
+    }
+
+    for (var t = 0; t + 2 < indices.length; t += 3) {
+      final a = indices[t], b = indices[t + 1], c = indices[t + 2];
+      final added = (local[a] < 0 ? 1 : 0) +
+          (local[b] < 0 && b != a ? 1 : 0) +
+          (local[c] < 0 && c != a && c != b ? 1 : 0);
+      if (vertices.length - vertexStart + added > maxVertices ||
+          (triangles.length - triangleStart) ~/ 3 >= maxTriangles) {
+        flush();
+      }
+      for (var k = 0; k < 3; ++k) {
+        final v = indices[t + k];
+        if (local[v] < 0) {
+          local[v] = vertices.length - vertexStart;
+          vertices.add(v);
+        }
+        triangles.add(local[v]);
+      }
+    }
+    flush();
+
+    final count = meshlets.length ~/ 4;
+    final bounds = Float32List(count * 12);
+    for (var m = 0; m < count; ++m) {
+      _bounds(positions, vertices, triangles, meshlets, m, bounds);
+    }
+    return Meshlets._(Uint32List.fromList(meshlets),
+        Uint32List.fromList(vertices), Uint8List.fromList(triangles), bounds);
+  }
+
+  static void _bounds(Float32List positions, List<int> vertices,
+      List<int> triangles, List<int> meshlets, int m, Float32List out) {
+    final vertexOffset = meshlets[m * 4], triangleOffset = meshlets[m * 4 + 1];
+    final vertexCount = meshlets[m * 4 + 2];
+    final triangleCount = meshlets[m * 4 + 3];
+
+    var minX = double.infinity, minY = double.infinity;
+    var minZ = double.infinity;
+    var maxX = -double.infinity, maxY = -double.infinity;
+    var maxZ = -double.infinity;
+    for (var i = 0; i < vertexCount; ++i) {
+      final p = vertices[vertexOffset + i] * 3;
+      minX = math.min(minX, positions[p]);
+      minY = math.min(minY, positions[p + 1]);
+      minZ = math.min(minZ, positions[p + 2]);
+      maxX = math.max(maxX, positions[p]);
+      maxY = math.max(maxY, positions[p + 1]);
+      maxZ = math.max(maxZ, positions[p + 2]);
+    }
+    final cx = (minX + maxX) / 2, cy = (minY + maxY) / 2;
+    final cz = (minZ + maxZ) / 2;
+    var radius = 0.0;
+    for (var i = 0; i < vertexCount; ++i) {
+      final p = vertices[vertexOffset + i] * 3;
+      final dx = positions[p] - cx, dy = positions[p + 1] - cy;
+      final dz = positions[p + 2] - cz;
+      radius = math.max(radius, dx * dx + dy * dy + dz * dz);
+    }
+
+    // unit normals of the triangles and their average
+    final normals = Float64List(triangleCount * 3);
+    var ax = 0.0, ay = 0.0, az = 0.0;
+    for (var t = 0; t < triangleCount; ++t) {
+      final base = (triangleOffset + t) * 3;
+      final a = vertices[vertexOffset + triangles[base]] * 3;
+      final b = vertices[vertexOffset + triangles[base + 1]] * 3;
+      final c = vertices[vertexOffset + triangles[base + 2]] * 3;
+      final e1x = positions[b] - positions[a];
+      final e1y = positions[b + 1] - positions[a + 1];
+      final e1z = positions[b + 2] - positions[a + 2];
+      final e2x = positions[c] - positions[a];
+      final e2y = positions[c + 1] - positions[a + 1];
+      final e2z = positions[c + 2] - positions[a + 2];
+      var nx = e1y * e2z - e1z * e2y;
+      var ny = e1z * e2x - e1x * e2z;
+      var nz = e1x * e2y - e1y * e2x;
+      final length = math.sqrt(nx * nx + ny * ny + nz * nz);
+      if (length > 0) {
+        nx /= length;
+        ny /= length;
+        nz /= length;
+      }
+      normals[t * 3] = nx;
+      normals[t * 3 + 1] = ny;
+      normals[t * 3 + 2] = nz;
+      ax += nx;
+      ay += ny;
+      az += nz;
+    }
+    final length = math.sqrt(ax * ax + ay * ay + az * az);
+    var minDot = 1.0;
+    if (length > 0) {
+      ax /= length;
+      ay /= length;
+      az /= length;
+      for (var t = 0; t < triangleCount; ++t) {
+        minDot = math.min(minDot, normals[t * 3] * ax +
+            normals[t * 3 + 1] * ay +
+            normals[t * 3 + 2] * az);
+      }
+    }
+
+    final o = m * 12;
+    out[o] = cx;
+    out[o + 1] = cy;
+    out[o + 2] = cz;
+    out[o + 3] = math.sqrt(radius);
+    if (length == 0 || minDot <= 0.1) {
+      // the normals spread over more than a hemisphere; never cull
+      out[o + 4] = cx;
+      out[o + 5] = cy;
+      out[o + 6] = cz;
+      out[o + 10] = 1;
+      return;
+    }
+
+    // move the apex back along the axis until every triangle plane is in
+    // front of it
+    var maxT = 0.0;
+    for (var t = 0; t < triangleCount; ++t) {
+      final a = vertices[vertexOffset + triangles[(triangleOffset + t) * 3]];
+      final nx = normals[t * 3], ny = normals[t * 3 + 1];
+      final nz = normals[t * 3 + 2];
+      final dc = (cx - positions[a * 3]) * nx +
+          (cy - positions[a * 3 + 1]) * ny +
+          (cz - positions[a * 3 + 2]) * nz;
+      final dn = ax * nx + ay * ny + az * nz;
+      maxT = math.max(maxT, dc / dn);
+    }
+    out[o + 4] = cx - ax * maxT;
+    out[o + 5] = cy - ay * maxT;
+    out[o + 6] = cz - az * maxT;
+    out[o + 7] = ax;
+    out[o + 8] = ay;
+    out[o + 9] = az;
+    out[o + 10] = math.sqrt(1 - minDot * minDot);
+  }
+}
+
+class _Adjacency {
+  _Adjacency(Uint32List indices, int vertexCount)
+      : counts = Uint32List(vertexCount),
+        offsets = Uint32List(vertexCount),
+        ends = Uint32List(vertexCount),
+        triangles = Uint32List(indices.length) {
+    for (var i = 0; i < indices.length; ++i) {
+      ++counts[indices[i]];
+    }
+    var offset = 0;
+    for (var v = 0; v < vertexCount; ++v) {
+      offsets[v] = offset;
+      ends[v] = offset;
+      offset += counts[v];
+    }
+    for (var i = 0; i < indices.length; ++i) {
+      triangles[ends[indices[i]]++] = i ~/ 3;
+    }
+  }
+
+  final Uint32List counts;
+  final Uint32List offsets;
+  final Uint32List ends;
+  final Uint32List triangles;
+
+  void remove(int v, int triangle) {
+    for (var k = offsets[v]; k < ends[v]; ++k) {
+      if (triangles[k] == triangle) {
+        triangles[k] = triangles[--ends[v]];
+        return;
+      }
+    }
+  }
+}
+
+/// Optimizes meshes for the GPU pipeline.
+extension MeshOptimize on Mesh {
+  /// Reorders the triangles of this mesh for the vertex cache and, unless
+  /// [overdrawThreshold] is `null`, for overdraw, and orders the vertices
+  /// for fetch locality.
+  ///
+  /// Only the triangle faces are optimized, see [Mesh.triangleIndexData].
+  /// The native data is not modified; apply [OptimizedMesh.remap] to the
+  /// vertex streams with [MeshOptimizer.remapVertices].
+  ///
+  /// The same [cacheSize] is targeted by the optimization and simulated for
+  /// the [OptimizedMesh.before] and [OptimizedMesh.after] statistics.
+  OptimizedMesh optimize(
+      {int cacheSize = 32, double? overdrawThreshold = 1.05}) {
+    final vertices = vertexData;
+    final count = vertices.length ~/ 3;
+    final source = triangleIndexData;
+    var indices =
+        MeshOptimizer.optimizeVertexCache(source, count, cacheSize: cacheSize);
+    if (overdrawThreshold != null) {
+      indices = MeshOptimizer.optimizeOverdraw(indices, vertices,
+          threshold: overdrawThreshold, cacheSize: cacheSize);
+    }
+    final remap = MeshOptimizer.optimizeVertexFetchRemap(indices, count);
+    indices = MeshOptimizer.remapIndices(indices, remap);
+    var used = 0;
+    for (final target in remap) {
+      if (target != MeshOptimizer.unused) ++used;
+    }
+    return OptimizedMesh(
+        indices,
+        remap,
+        used,
+        MeshOptimizer.analyzeVertexCache(source, count, cacheSize: cacheSize),
+        MeshOptimizer.analyzeVertexCache(indices, used, cacheSize: cacheSize));
+  }
+
+  /// Splits this mesh into meshlets, see [MeshOptimizer.buildMeshlets].
+  ///
+  /// The triangles are optimized for the vertex cache first. Point and line
+  /// faces are skipped, see [Mesh.triangleIndexData].
+  Meshlets buildMeshlets({int maxVertices = 64, int maxTriangles = 124}) {
+    final vertices = vertexData;
+    final indices = MeshOptimizer.optimizeVertexCache(
+        triangleIndexData, vertices.length ~/ 3);
+    return MeshOptimizer.buildMeshlets(indices, vertices,
+        maxVertices: maxVertices, maxTriangles: maxTriangles);
+  }
+}
@@ -66,7 +66,7 @@ class MetaData extends AssimpType<aiMetadata> {
   Iterable<String> get keys {
     return Iterable.generate(
       _metaData.mNumProperties,
-      (i) => AssimpString.fromNative(_metaData.mKeys.elementAt(i).ref),
+      (i) => AssimpString.fromPointer(_metaData.mKeys.elementAt(i)),
     );
   }
 
@@ -0,0 +1,201 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:io';
+
+import 'package:ffi/ffi.dart';
+
+typedef _c_open = Int32 Function(Pointer<Utf8> path, Int32 flags);
+typedef _dart_open = int Function(Pointer<Utf8> path, int flags);
+typedef _c_close = Int32 Function(Int32 fd);
+typedef _dart_close = int Function(int fd);
+typedef _c_mmap = Pointer<Void> Function(Pointer<Void> addr, IntPtr length,
+    Int32 prot, Int32 flags, Int32 fd, IntPtr offset);
+typedef _dart_mmap = Pointer<Void> Function(Pointer<Void> addr, int length,
+    int prot, int flags, int fd, int offset);
+typedef _c_munmap = Int32 Function(Pointer<Void> addr, IntPtr length);
+typedef _dart_munmap = int Function(Pointer<Void> addr, int length);
+
+typedef _c_CreateFileW = Pointer<Void> Function(
+    Pointer<Utf16> name,
+    Uint32 access,
+    Uint32 share,
+    Pointer<Void> security,
+    Uint32 creation,
+    Uint32 flags,
+    Pointer<Void> template);
+typedef _dart_CreateFileW = Pointer<Void> Function(
+    Pointer<Utf16> name,
+    int access,
+    int share,
+    Pointer<Void> security,
+    int creation,
+    int flags,
+    Pointer<Void> template);
+typedef _c_CreateFileMappingW = Pointer<Void> Function(
+    Pointer<Void> file,
+    Pointer<Void> security,
+    Uint32 protect,
+    Uint32 sizeHigh,
+    Uint32 sizeLow,
+    Pointer<Utf16> name);
+typedef _dart_CreateFileMappingW = Pointer<Void> Function(
+    Pointer<Void> file,
+    Pointer<Void> security,
+    int protect,
+    int sizeHigh,
+    int sizeLow,
+    Pointer<Utf16> name);
+typedef _c_MapViewOfFile = Pointer<Void> Function(Pointer<Void> mapping,
+    Uint32 access, Uint32 offsetHigh, Uint32 offsetLow, IntPtr size);
+typedef _dart_MapViewOfFile = Pointer<Void> Function(Pointer<Void> mapping,
+    int access, int offsetHigh, int offsetLow, int size);
+typedef _c_UnmapViewOfFile = Int32 Function(Pointer<Void> address);
+typedef _dart_UnmapViewOfFile = int Function(Pointer<Void> address);
+typedef _c_CloseHandle = Int32 Function(Pointer<Void> handle);
+typedef _dart_CloseHandle = int Function(Pointer<Void> handle);
+
+const int _O_RDONLY = 0;
+const int _PROT_READ = 0x1;
+const int _MAP_PRIVATE = 0x2;
+
+const int _GENERIC_READ = 0x80000000;
+const int _FILE_SHARE_READ = 0x1;
+const int _OPEN_EXISTING = 3;
+const int _FILE_ATTRIBUTE_NORMAL = 0x80;
+const int _PAGE_READONLY = 0x2;
+const int _FILE_MAP_READ = 0x4;
+
+/// A read-only memory mapping of a file.
+///
+/// The contents of the file are paged in by the operating system on demand,
+/// so mapping even a large file is cheap and the mapped pages do not count
+/// against the Dart heap. Call [dispose] to unmap the file.
+class MappedFile {
+  /// The start of the mapped file contents.
+  final Pointer<Uint8> data;
+
+  /// The size of the mapped file, in bytes.
+  final int length;
+
+  final void Function() _unmap;
+  bool _disposed = false;
+
+  MappedFile._(this.data, this.length, this._unmap);
+
+  /// Maps the file at [path] into memory for reading.
+  ///
+  /// Throws a [FileSystemException] if the file cannot be opened or mapped.
+  /// Empty files cannot be mapped.
+  static MappedFile open(String path) {
+    final length = File(path).lengthSync();
+    if (length == 0) {
+      throw FileSystemException('Cannot map an empty file', path);
+    }
+    return Platform.isWindows
+        ? _openWindows(path, length)
+        : _openPosix(path, length);
+  }
+
+  /// Unmaps the file. The [data] pointer must not be used afterwards.
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _unmap();
+  }
+
+  static MappedFile _openPosix(String path, int length) {
+    final libc = DynamicLibrary.process();
+    final open = libc.lookupFunction<_c_open, _dart_open>('open');
+    final close = libc.lookupFunction<_c_close, _dart_close>('close');
+    final mmap = libc.lookupFunction<_c_mmap, _dart_mmap>('mmap');
+    final munmap = libc.lookupFunction<_c_munmap, _dart_munmap>('munmap');
+
+    final cpath = path.toNativeUtf8();
+    final fd = open(cpath, _O_RDONLY);
+    malloc.free(cpath);
+    if (fd < 0) throw FileSystemException('Cannot open file', path);
+
+    final addr = mmap(nullptr, length, _PROT_READ, _MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor has been closed
+    close(fd);
+    if (addr.address == -1) {
+      throw FileSystemException('Cannot map file', path);
+    }
+    return MappedFile._(addr.cast<Uint8>(), length, () => munmap(addr, length));
+  }
+
+  static MappedFile _openWindows(String path, int length) {
+    final kernel32 = DynamicLibrary.open('kernel32.dll');
+    final createFile = kernel32
+        .lookupFunction<_c_CreateFileW, _dart_CreateFileW>('CreateFileW');
+    final createFileMapping =
+        kernel32.lookupFunction<_c_CreateFileMappingW, _dart_CreateFileMappingW>(
+            'CreateFileMappingW');
+    final mapViewOfFile = kernel32
+        .lookupFunction<_c_MapViewOfFile, _dart_MapViewOfFile>('MapViewOfFile');
+    final unmapViewOfFile =
+        kernel32.lookupFunction<_c_UnmapViewOfFile, _dart_UnmapViewOfFile>(
+            'UnmapViewOfFile');
+    final closeHandle = kernel32
+        .lookupFunction<_c_CloseHandle, _dart_CloseHandle>('CloseHandle');
+
+    final cpath = path.toNativeUtf16();
+    final file = createFile(cpath, _GENERIC_READ, _FILE_SHARE_READ, nullptr,
+        _OPEN_EXISTING, _FILE_ATTRIBUTE_NORMAL, nullptr);
+    malloc.free(cpath);
+    if (file.address == -1) throw FileSystemException('Cannot open file', path);
+
+    final mapping =
+        createFileMapping(file, nullptr, _PAGE_READONLY, 0, 0, nullptr);
+    closeHandle(file);
+    if (mapping == nullptr) throw FileSystemException('Cannot map file', path);
+
+    final addr = mapViewOfFile(mapping, _FILE_MAP_READ, 0, 0, 0);
+    closeHandle(mapping);
+    if (addr == nullptr) throw FileSystemException('Cannot map file', path);
+    return MappedFile._(
+        addr.cast<Uint8>(), length, () => unmapViewOfFile(addr));
+  }
+}
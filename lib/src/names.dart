@@ -0,0 +1,106 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:collection';
+import 'dart:ffi';
+
+import 'bindings.dart';
+import 'extensions.dart';
+import 'lookup.dart';
+import 'scene.dart';
+
+/// A table of interned names with stable integer ids.
+///
+/// Each distinct name gets the next free id when it is first interned, and
+/// keeps it for the lifetime of the table. Code that resolves node, bone and
+/// channel names against each other can compare the ids instead of the
+/// strings.
+class NameTable {
+  NameTable();
+
+  /// Interns the names of all nodes, bones and animation channels of
+  /// [scene].
+  ///
+  /// Node names are interned first in depth-first preorder, in the same
+  /// order as [FlatHierarchy.fromNode], so the node name ids match the
+  /// [FlatHierarchy.nameIds] of the scene. Names that only occur on bones
+  /// or channels follow.
+  factory NameTable.fromScene(Scene scene) {
+    return SceneIndex.fromScene(scene).names;
+  }
+
+  final _ids = <String, int>{};
+  final _names = <String>[];
+  late final _view = UnmodifiableListView(_names);
+
+  /// The interned names, indexed by id.
+  ///
+  /// The list is a view and grows as names are interned.
+  List<String> get names => _view;
+
+  /// The number of interned names.
+  int get length => _names.length;
+
+  /// Returns the id of [name], interning it if needed.
+  int intern(String name) {
+    return _ids.putIfAbsent(name, () {
+      _names.add(name);
+      return _names.length - 1;
+    });
+  }
+
+  /// Decodes the native string at [ptr] and returns its id, interning it
+  /// if needed.
+  int internNative(Pointer<aiString> ptr) {
+    return intern(AssimpString.fromPointer(ptr));
+  }
+
+  /// Returns the id of [name], or -1 if it has not been interned.
+  int idOf(String name) => _ids[name] ?? -1;
+
+  /// Whether [name] has been interned.
+  bool contains(String name) => _ids.containsKey(name);
+
+  /// The name with the given [id].
+  String nameOf(int id) => _names[id];
+}
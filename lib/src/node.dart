@@ -46,6 +46,7 @@ import 'dart:ffi';
 import 'package:vector_math/vector_math.dart';
 
 import 'bindings.dart';
+import 'cached.dart';
 import 'metadata.dart';
 import 'extensions.dart';
 import 'type.dart';
@@ -86,11 +87,17 @@ class Node extends AssimpType<aiNode> {
   /// source hierarchy format is simply not compatible). Their names are
   /// surrounded by @verbatim <> @endverbatim e.g.
   /// @verbatim<DummyRootNode> @endverbatim.
-  String get name => AssimpString.fromNative(_node.mName);
+  String get name {
+    // mName is the first member of aiNode.
+    return AssimpString.fromPointer(ptr.cast());
+  }
 
   /// The transformation relative to the node's parent.
   Matrix4 get transformation => AssimpMatrix4.fromNative(_node.mTransformation);
-  set transformation(Matrix4 matrix) => _node.mTransformation.toNative(matrix);
+  set transformation(Matrix4 matrix) {
+    _node.mTransformation.toNative(matrix);
+    CachedScene.markTransformChanged(ptr);
+  }
 
   /// Parent node. NULL if this node is the root node.
   Node? get parent => Node.fromNative(_node.mParent);
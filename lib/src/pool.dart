@@ -0,0 +1,427 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'assimp.dart';
+import 'bindings.dart';
+import 'libassimp.dart';
+import 'logstream.dart';
+import 'scene.dart';
+
+/// Thrown when an asynchronous import fails.
+class ImportException implements Exception {
+  /// The error text reported by Assimp, see [Assimp.errorString].
+  ///
+  /// Assimp keeps the error of the last failed import in a single global
+  /// string. When several workers fail at the same time, the message may
+  /// therefore describe the failure of another import. If the string is
+  /// empty, the message names the file or format that failed instead.
+  final String message;
+
+  const ImportException(this.message);
+
+  @override
+  String toString() => 'ImportException: $message';
+}
+
+/// Thrown when an asynchronous import is cancelled through a [CancelToken].
+class ImportCancelledException extends ImportException {
+  const ImportCancelledException([String message = 'Import cancelled'])
+      : super(message);
+
+  @override
+  String toString() => 'ImportCancelledException: $message';
+}
+
+/// Cancels pending or running asynchronous imports.
+///
+/// An import that is still queued is dropped without ever reaching a worker.
+/// A native import cannot be interrupted once it has started, so cancelling
+/// a running import completes it right away with an [ImportCancelledException]
+/// and releases the resulting scene as soon as the worker hands it back.
+class CancelToken {
+  bool _cancelled = false;
+  final _listeners = <void Function()>[];
+
+  /// Whether [cancel] has been called.
+  bool get isCancelled => _cancelled;
+
+  /// Cancels all imports associated with this token.
+  void cancel() {
+    if (_cancelled) return;
+    _cancelled = true;
+    for (final listener in List.of(_listeners)) {
+      listener();
+    }
+    _listeners.clear();
+  }
+
+  void _addListener(void Function() listener) => _listeners.add(listener);
+  void _removeListener(void Function() listener) =>
+      _listeners.remove(listener);
+}
+
+/// A request handler that runs on a worker isolate.
+///
+/// Receives the request arguments and returns `[result, error]`, where a
+/// non-null error string indicates a failure.
+typedef _Handler = List<Object?> Function(List<Object?> args);
+
+class _Job {
+  final _Handler task;
+  final List<Object?> args;
+  final CancelToken? cancelToken;
+  final void Function(Object? result)? discard;
+  final completer = Completer<Object?>();
+  void Function()? onCancel;
+  bool running = false;
+
+  _Job(this.task, this.args, this.cancelToken, this.discard);
+}
+
+class _Worker {
+  final ReceivePort replies;
+  SendPort? requests;
+  _Job? job;
+  Timer? idleTimer;
+
+  _Worker(this.replies);
+}
+
+/// A bounded pool of worker isolates that run native imports off the
+/// calling isolate.
+///
+/// Assimp imports are synchronous and may take seconds for large files. An
+/// [ImportPool] runs them on up to [size] background isolates at once, so
+/// several imports proceed on different cores while the calling isolate
+/// keeps serving its event loop. The imported `aiScene` stays in native
+/// memory and is handed back by address, so no scene data is copied between
+/// isolates.
+///
+/// Workers are spawned on demand and shut down after being idle for
+/// [idleTimeout], so an unused pool does not keep the program alive.
+///
+/// Imports fail with a [StateError] while a [LogStream] is attached, see
+/// [LogStream].
+class ImportPool {
+  /// Creates a pool of at most [size] workers.
+  ///
+  /// Defaults to the number of processors.
+  ImportPool({int? size, this.idleTimeout = const Duration(seconds: 1)})
+      : size = size ?? Platform.numberOfProcessors,
+        assert(size == null || size > 0);
+
+  static ImportPool? _shared;
+
+  /// The pool used by [Scene.importAsync].
+  static ImportPool get shared => _shared ??= ImportPool();
+
+  /// The maximum number of concurrent worker isolates.
+  final int size;
+
+  /// How long an idle worker is kept around before it is shut down.
+  final Duration idleTimeout;
+
+  final _queue = Queue<_Job>();
+  final _idle = <_Worker>[];
+  int _workers = 0;
+  int _starting = 0;
+  bool _closed = false;
+
+  /// The number of imports waiting for a worker.
+  int get pending => _queue.length;
+
+  static int _running = 0;
+  static int _queued = 0;
+
+  /// The number of imports running on the workers of all pools.
+  static int get running => _running;
+
+  /// The number of imports queued or running on all pools.
+  static int get active => _queued + _running;
+
+  /// Reads the given file on a worker isolate.
+  ///
+  /// Completes with the imported scene, or with an [ImportException] if the
+  /// import fails. See [Scene.fromFile] for the meaning of [flags] and
+  /// [properties].
+  Future<Scene> importFile(String path,
+      {int flags = 0,
+      Map<String, dynamic>? properties,
+      CancelToken? cancelToken}) {
+    return _submit(_importFile, [path, flags, properties], cancelToken,
+            _release)
+        .then(_toScene);
+  }
+
+  /// Reads the given file from a given memory buffer on a worker isolate.
+  ///
+  /// The bytes are copied once into a transferable buffer that moves to the
+  /// worker without further copies. See [Scene.fromBytes] for the meaning of
+  /// [flags], [properties] and [hint].
+  Future<Scene> importBytes(Uint8List bytes,
+      {int flags = 0,
+      Map<String, dynamic>? properties,
+      String hint = '',
+      CancelToken? cancelToken}) {
+    final data = TransferableTypedData.fromList([bytes]);
+    return _submit(_importBytes, [data, flags, properties, hint], cancelToken,
+            _release)
+        .then(_toScene);
+  }
+
+  /// Runs [task] with [args] on a worker isolate.
+  ///
+  /// [task] must be a static or top-level function. It receives [args] and
+  /// returns `[result, error]`, where a non-null error string fails the
+  /// returned future with an [ImportException]. If the task is cancelled
+  /// while running, its result is passed to [discard] once the worker hands
+  /// it back.
+  ///
+  /// @internal
+  Future<Object?> run(List<Object?> Function(List<Object?> args) task,
+      List<Object?> args,
+      {CancelToken? cancelToken, void Function(Object? result)? discard}) {
+    return _submit(task, args, cancelToken, discard);
+  }
+
+  /// Stops accepting imports and shuts down the workers.
+  ///
+  /// Queued imports fail with an [ImportCancelledException]. Running imports
+  /// are allowed to finish.
+  void close() {
+    if (_closed) return;
+    _closed = true;
+    while (_queue.isNotEmpty) {
+      _fail(_dequeue(), const ImportCancelledException('ImportPool closed'));
+    }
+    for (final worker in List.of(_idle)) {
+      _shutdown(worker);
+    }
+    _idle.clear();
+    if (identical(this, _shared)) _shared = null;
+  }
+
+  Future<Object?> _submit(_Handler task, List<Object?> args,
+      CancelToken? cancelToken, void Function(Object? result)? discard) {
+    if (_closed) throw StateError('ImportPool is closed');
+    if (LogStream.isAttached) {
+      return Future.error(
+          StateError('Cannot import on an ImportPool while a LogStream is '
+              'attached'));
+    }
+    if (cancelToken?.isCancelled == true) {
+      return Future.error(const ImportCancelledException());
+    }
+    final job = _Job(task, args, cancelToken, discard);
+    if (cancelToken != null) {
+      job.onCancel = () => _cancel(job);
+      cancelToken._addListener(job.onCancel!);
+    }
+    _queue.add(job);
+    ++_queued;
+    _schedule();
+    return job.completer.future;
+  }
+
+  _Job _dequeue() {
+    --_queued;
+    return _queue.removeFirst();
+  }
+
+  void _schedule() {
+    while (_queue.isNotEmpty && _idle.isNotEmpty) {
+      _run(_idle.removeLast());
+    }
+    var needed = _queue.length - _starting;
+    while (needed-- > 0 && _workers < size) {
+      _spawn();
+    }
+  }
+
+  void _spawn() {
+    ++_workers;
+    ++_starting;
+    final worker = _Worker(ReceivePort());
+    worker.replies.listen((message) {
+      if (message is SendPort) {
+        --_starting;
+        worker.requests = message;
+        _ready(worker);
+      } else {
+        _finish(worker, message as List<Object?>);
+      }
+    });
+    Isolate.spawn(_main, worker.replies.sendPort).catchError((Object error) {
+      --_starting;
+      --_workers;
+      worker.replies.close();
+      while (_queue.isNotEmpty && _workers == 0) {
+        _fail(_dequeue(), ImportException(error.toString()));
+      }
+      return Isolate.current;
+    });
+  }
+
+  void _run(_Worker worker) {
+    final job = _dequeue();
+    worker.idleTimer?.cancel();
+    worker.idleTimer = null;
+    worker.job = job;
+    job.running = true;
+    ++_running;
+    worker.requests!.send([job.task, ...job.args]);
+  }
+
+  void _ready(_Worker worker) {
+    if (_closed) {
+      _shutdown(worker);
+    } else if (_queue.isNotEmpty) {
+      _run(worker);
+    } else {
+      _idle.add(worker);
+      worker.idleTimer = Timer(idleTimeout, () {
+        _idle.remove(worker);
+        _shutdown(worker);
+      });
+    }
+  }
+
+  void _finish(_Worker worker, List<Object?> reply) {
+    final job = worker.job!;
+    worker.job = null;
+    --_running;
+    if (job.onCancel != null) job.cancelToken!._removeListener(job.onCancel!);
+    final result = reply[0];
+    final error = reply[1] as String?;
+    if (job.completer.isCompleted) {
+      if (error == null) job.discard?.call(result);
+    } else if (error != null) {
+      job.completer.completeError(ImportException(error));
+    } else {
+      job.completer.complete(result);
+    }
+    _ready(worker);
+  }
+
+  void _cancel(_Job job) {
+    if (!job.running && _queue.remove(job)) --_queued;
+    _fail(job, const ImportCancelledException());
+  }
+
+  void _fail(_Job job, ImportException error) {
+    if (job.onCancel != null) job.cancelToken!._removeListener(job.onCancel!);
+    if (!job.completer.isCompleted) job.completer.completeError(error);
+  }
+
+  void _shutdown(_Worker worker) {
+    worker.idleTimer?.cancel();
+    worker.requests?.send(null);
+    worker.replies.close();
+    --_workers;
+  }
+
+  static Scene _toScene(Object? address) {
+    return Scene.fromNative(Pointer<aiScene>.fromAddress(address as int))!;
+  }
+
+  static void _release(Object? address) {
+    libassimp.aiReleaseImport(Pointer<aiScene>.fromAddress(address as int));
+  }
+
+  static void _main(SendPort replies) {
+    final requests = ReceivePort();
+    replies.send(requests.sendPort);
+    requests.listen((message) {
+      if (message == null) {
+        requests.close();
+        return;
+      }
+      final request = message as List<Object?>;
+      try {
+        final task = request[0] as _Handler;
+        replies.send(task(request.sublist(1)));
+      } catch (e) {
+        replies.send([null, e.toString()]);
+      }
+    });
+  }
+
+  // The global error string of Assimp is shared by all workers, so it is
+  // read right after the failure and may still be empty or stale.
+  static String _error(String fallback) {
+    final error = Assimp.errorString;
+    return error.isEmpty ? fallback : error;
+  }
+
+  static List<Object?> _reply(Scene? scene, String source) {
+    if (scene == null) return [null, _error('Failed to import $source')];
+    return [scene.ptr.address, null];
+  }
+
+  static List<Object?> _importFile(List<Object?> args) {
+    final path = args[0] as String;
+    return _reply(
+        Scene.fromFile(path,
+            flags: args[1] as int,
+            properties: args[2] as Map<String, dynamic>?),
+        path);
+  }
+
+  static List<Object?> _importBytes(List<Object?> args) {
+    final data = args[0] as TransferableTypedData;
+    final hint = args[3] as String;
+    return _reply(
+        Scene.fromBytes(data.materialize().asUint8List(),
+            flags: args[1] as int,
+            properties: args[2] as Map<String, dynamic>?,
+            hint: hint),
+        hint.isEmpty ? 'bytes' : '.$hint bytes');
+  }
+}
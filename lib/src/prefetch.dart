@@ -0,0 +1,247 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'filesystem.dart';
+import 'material.dart';
+import 'scene.dart';
+
+/// A texture referenced by the materials of a scene.
+class TextureDependency {
+  TextureDependency._(this.reference, this.path, this.embeddedIndex);
+
+  /// The texture path as stored in the material, e.g. `tex\wood.png` or
+  /// `*0`.
+  final String reference;
+
+  /// The resolved file path, or `null` for embedded textures.
+  final String? path;
+
+  /// The index in [Scene.textures] of an embedded texture, or `null` for
+  /// external files.
+  final int? embeddedIndex;
+
+  /// The texture types that the texture is used as.
+  final Set<TextureType> types = {};
+
+  /// The indices of the materials that reference the texture.
+  final Set<int> materials = {};
+
+  /// Whether the texture is embedded in the scene.
+  bool get isEmbedded => embeddedIndex != null;
+
+  /// Collects the textures referenced by the materials of [scene], which
+  /// was imported from [modelPath].
+  ///
+  /// References are resolved relative to the directory of [modelPath], with
+  /// backslashes treated as separators. If a referenced file does not exist,
+  /// the file name is also looked up next to the model, since exporters
+  /// often store absolute paths of the authoring machine. `*N` references
+  /// and references that match the file name of an embedded texture resolve
+  /// to [Scene.textures]. Each distinct texture is reported once.
+  static List<TextureDependency> collect(Scene scene, String modelPath) {
+    final directory = File(modelPath).parent.path;
+    final embedded = <String, int>{};
+    var t = 0;
+    for (final texture in scene.textures) {
+      final name = _baseName(texture.fileName);
+      if (name.isNotEmpty) embedded.putIfAbsent(name, () => t);
+      ++t;
+    }
+    final textureCount = t;
+
+    final dependencies = <String, TextureDependency>{};
+    var m = 0;
+    for (final material in scene.materials) {
+      final index = material.index;
+      for (final type in TextureType.values) {
+        final count = index.textureCount(type);
+        for (var i = 0; i < count; ++i) {
+          final reference = index.getTexture(type, i)!.path;
+          if (reference.isEmpty) continue;
+          final dependency = dependencies.putIfAbsent(reference, () {
+            return _resolve(reference, directory, embedded, textureCount);
+          });
+          dependency.types.add(type);
+          dependency.materials.add(m);
+        }
+      }
+      ++m;
+    }
+
+    // different references may resolve to the same file
+    final unique = <String, TextureDependency>{};
+    for (final dependency in dependencies.values) {
+      final key = dependency.path ?? '*${dependency.embeddedIndex}';
+      final existing = unique[key];
+      if (existing == null) {
+        unique[key] = dependency;
+      } else {
+        existing.types.addAll(dependency.types);
+        existing.materials.addAll(dependency.materials);
+      }
+    }
+    return unique.values.toList();
+  }
+
+  static TextureDependency _resolve(String reference, String directory,
+      Map<String, int> embedded, int textureCount) {
+    if (reference.startsWith('*')) {
+      final index = int.tryParse(reference.substring(1));
+      if (index != null && index >= 0 && index < textureCount) {
+        return TextureDependency._(reference, null, index);
+      }
+    }
+    final name = _baseName(reference);
+    final index = embedded[name];
+    if (index != null) return TextureDependency._(reference, null, index);
+
+    final normalized = reference.replaceAll('\\', '/');
+    final absolute = normalized.startsWith('/') ||
+        RegExp(r'^[A-Za-z]:/').hasMatch(normalized);
+    final path = absolute
+        ? normalized
+        : FileSystem.normalize('$directory/$normalized');
+    if (!File(path).existsSync()) {
+      final sibling = FileSystem.normalize('$directory/$name');
+      if (File(sibling).existsSync()) {
+        return TextureDependency._(reference, sibling, null);
+      }
+    }
+    return TextureDependency._(reference, path, null);
+  }
+
+  static String _baseName(String path) {
+    final normalized = path.replaceAll('\\', '/');
+    return normalized.substring(normalized.lastIndexOf('/') + 1);
+  }
+
+  @override
+  String toString() => 'TextureDependency(${path ?? reference})';
+}
+
+/// Reads external texture files concurrently.
+///
+/// Reading starts as soon as the prefetcher is created, with at most
+/// [concurrency] files open at a time, so that texture I/O overlaps with
+/// the processing of mesh data:
+///
+/// ```dart
+/// final scene = Scene.fromFile(path)!;
+/// final prefetcher = TexturePrefetcher(scene.textureDependencies(path));
+/// uploadMeshes(scene);
+/// final images = await prefetcher.done;
+/// ```
+///
+/// Embedded textures are skipped, since their data is already in memory.
+class TexturePrefetcher {
+  /// Starts reading the files of [dependencies].
+  TexturePrefetcher(Iterable<TextureDependency> dependencies,
+      {int concurrency = 8})
+      : concurrency = math.max(1, concurrency) {
+    for (final dependency in dependencies) {
+      final path = dependency.path;
+      if (path == null || _files.containsKey(path)) continue;
+      _files[path] = Completer<Uint8List>();
+      _queue.add(path);
+    }
+    for (var i = 0; i < this.concurrency && _next < _queue.length; ++i) {
+      _readNext();
+    }
+    if (_files.isEmpty) _done.complete(_loaded);
+  }
+
+  /// The maximum number of files read at a time, at least one.
+  final int concurrency;
+
+  final _files = <String, Completer<Uint8List>>{};
+  final _queue = <String>[];
+  final _loaded = <String, Uint8List>{};
+  final _errors = <String, Object>{};
+  final _done = Completer<Map<String, Uint8List>>();
+  var _next = 0;
+  var _settled = 0;
+
+  /// The paths of the files being prefetched.
+  Iterable<String> get paths => _files.keys;
+
+  /// Returns the contents of the file at [path], which must be one of
+  /// [paths].
+  ///
+  /// Completes with an error if the file could not be read.
+  Future<Uint8List> operator [](String path) {
+    final file = _files[path];
+    if (file == null) throw ArgumentError.value(path, 'path', 'not prefetched');
+    return file.future;
+  }
+
+  /// Completes with the contents of all files that could be read, by path,
+  /// once all reads have finished.
+  Future<Map<String, Uint8List>> get done => _done.future;
+
+  /// The errors of the files that could not be read, by path.
+  ///
+  /// Only complete once [done] has completed.
+  Map<String, Object> get errors => _errors;
+
+  void _readNext() {
+    final path = _queue[_next++];
+    final file = _files[path]!;
+    File(path).readAsBytes().then((bytes) {
+      _loaded[path] = bytes;
+      file.complete(bytes);
+    }, onError: (Object error, StackTrace stack) {
+      _errors[path] = error;
+      // nobody may ask for this file; the error is reported in [errors]
+      file.future.catchError((_) => Uint8List(0));
+      file.completeError(error, stack);
+    }).whenComplete(() {
+      if (_next < _queue.length) _readNext();
+      if (++_settled == _queue.length) _done.complete(_loaded);
+    });
+  }
+}
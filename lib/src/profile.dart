@@ -0,0 +1,196 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+
+import 'cached.dart';
+import 'libassimp.dart';
+import 'material.dart';
+import 'meminfo.dart';
+import 'process.dart';
+import 'scene.dart';
+
+/// The cost and effect of a single post-processing step.
+class ProcessStepReport {
+  ProcessStepReport._(this.flag, this.name, this.time, this.before, this.after);
+
+  /// The [ProcessFlags] value of the step.
+  final int flag;
+
+  /// The name of the step, such as `joinIdenticalVertices`.
+  final String name;
+
+  /// The wall time spent in the step.
+  final Duration time;
+
+  /// The scene statistics before the step.
+  final SceneStats before;
+
+  /// The scene statistics after the step, or `null` if the step failed.
+  final SceneStats? after;
+
+  /// Whether the step failed, which releases the scene.
+  bool get failed => after == null;
+
+  @override
+  String toString() {
+    final after = this.after;
+    if (after == null) return '$name: failed after ${time.inMicroseconds} us';
+    return '$name: ${time.inMicroseconds} us, '
+        'vertices ${before.vertices} -> ${after.vertices}, '
+        'faces ${before.faces} -> ${after.faces}, '
+        'memory ${after.memory - before.memory >= 0 ? '+' : ''}'
+        '${after.memory - before.memory} bytes';
+  }
+}
+
+/// Vertex, face and memory totals of a scene.
+class SceneStats {
+  const SceneStats._(this.vertices, this.faces, this.memory);
+
+  /// Collects the statistics of [scene].
+  factory SceneStats.of(Scene scene) {
+    final native = scene.ptr.ref;
+    var vertices = 0;
+    var faces = 0;
+    for (var i = 0; i < native.mNumMeshes; ++i) {
+      final mesh = native.mMeshes[i].ref;
+      vertices += mesh.mNumVertices;
+      faces += mesh.mNumFaces;
+    }
+    final info = MemoryInfo.fromScene(scene);
+    final memory = info.total;
+    info.dispose();
+    return SceneStats._(vertices, faces, memory);
+  }
+
+  /// The total number of vertices in all meshes.
+  final int vertices;
+
+  /// The total number of faces in all meshes.
+  final int faces;
+
+  /// The memory used by the scene, see [MemoryInfo.total].
+  final int memory;
+}
+
+/// A per-step profile of post-processing, see [Scene.profilePostProcess].
+class ProcessReport {
+  ProcessReport._(this.steps);
+
+  /// The steps in the order they were applied.
+  final List<ProcessStepReport> steps;
+
+  /// Whether a step failed, which releases the scene.
+  bool get failed => steps.isNotEmpty && steps.last.failed;
+
+  /// The total time spent in all steps.
+  Duration get time =>
+      steps.fold(Duration.zero, (sum, step) => sum + step.time);
+
+  /// Returns the steps sorted by descending time.
+  List<ProcessStepReport> get slowest =>
+      List.of(steps)..sort((a, b) => b.time.compareTo(a.time));
+
+  @override
+  String toString() => steps.join('\n');
+
+  /// The steps in the order of Assimp's post-processing pipeline.
+  static const pipeline = <int, String>{
+    ProcessFlags.validateDataStructure: 'validateDataStructure',
+    ProcessFlags.makeLeftHanded: 'makeLeftHanded',
+    ProcessFlags.flipUVs: 'flipUVs',
+    ProcessFlags.flipWindingOrder: 'flipWindingOrder',
+    ProcessFlags.removeComponent: 'removeComponent',
+    ProcessFlags.removeRedundantMaterials: 'removeRedundantMaterials',
+    ProcessFlags.embedTextures: 'embedTextures',
+    ProcessFlags.findInstances: 'findInstances',
+    ProcessFlags.optimizeGraph: 'optimizeGraph',
+    ProcessFlags.optimizeMeshes: 'optimizeMeshes',
+    ProcessFlags.findDegenerates: 'findDegenerates',
+    ProcessFlags.generateUVCoords: 'generateUVCoords',
+    ProcessFlags.transformUVCoords: 'transformUVCoords',
+    ProcessFlags.globalScale: 'globalScale',
+    ProcessFlags.preTransformVertices: 'preTransformVertices',
+    ProcessFlags.triangulate: 'triangulate',
+    ProcessFlags.sortByPType: 'sortByPType',
+    ProcessFlags.findInvalidData: 'findInvalidData',
+    ProcessFlags.fixInfacingNormals: 'fixInfacingNormals',
+    ProcessFlags.splitByBoneCount: 'splitByBoneCount',
+    ProcessFlags.splitLargeMeshes: 'splitLargeMeshes',
+    ProcessFlags.dropNormals: 'dropNormals',
+    ProcessFlags.generateNormals: 'generateNormals',
+    ProcessFlags.generateSmoothNormals: 'generateSmoothNormals',
+    ProcessFlags.calculateTangentSpace: 'calculateTangentSpace',
+    ProcessFlags.joinIdenticalVertices: 'joinIdenticalVertices',
+    ProcessFlags.debone: 'debone',
+    ProcessFlags.limitBoneWeights: 'limitBoneWeights',
+    ProcessFlags.improveCacheLocality: 'improveCacheLocality',
+    ProcessFlags.generateBoundingBoxes: 'generateBoundingBoxes',
+  };
+
+  // Flags that modify other steps instead of running on their own.
+  static const _modifiers = ProcessFlags.forceGenerateNormals;
+
+  /// @internal
+  static ProcessReport run(Scene scene, int flags) {
+    final modifiers = flags & _modifiers;
+    final steps = <ProcessStepReport>[];
+    var before = SceneStats.of(scene);
+    for (final step in pipeline.entries) {
+      if (flags & step.key == 0) continue;
+      Material.release(scene.ptr);
+      final watch = Stopwatch()..start();
+      final result =
+          libassimp.aiApplyPostProcessing(scene.ptr, step.key | modifiers);
+      watch.stop();
+      CachedScene.markTopologyChanged(scene.ptr);
+      final after = result == nullptr ? null : SceneStats.of(scene);
+      steps.add(ProcessStepReport._(
+          step.key, step.value, watch.elapsed, before, after));
+      if (after == null) break;
+      before = after;
+    }
+    return ProcessReport._(List.unmodifiable(steps));
+  }
+}
@@ -0,0 +1,426 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'animation.dart';
+import 'bindings.dart';
+import 'extensions.dart';
+import 'node.dart';
+
+/// The layout of the transforms written by [AnimationSampler].
+enum SampleLayout {
+  /// 10 floats per channel: translation (x, y, z), rotation quaternion
+  /// (x, y, z, w) and scaling (x, y, z).
+  trs,
+
+  /// 16 floats per channel: a local transformation matrix in the
+  /// column-major order of [Matrix4.storage].
+  matrix,
+}
+
+/// Evaluates all channels of an [Animation] at a given time.
+///
+/// Keys are read directly from the native key arrays. Each channel caches
+/// the key interval it last sampled, so sequential playback finds the next
+/// interval in constant time and only jumps fall back to a binary search.
+///
+/// Positions and scalings are interpolated linearly, rotations spherically.
+/// Times before the first or after the last key are handled according to
+/// [NodeAnim.preState] and [NodeAnim.postState]:
+/// - [AnimBehavior.defaults] uses the transformation of the animated node,
+///   if a root node was passed to the sampler, or the nearest key otherwise.
+/// - [AnimBehavior.constant] uses the nearest key.
+/// - [AnimBehavior.linear] extrapolates the nearest two keys. Rotations are
+///   not extrapolated and use the nearest key.
+/// - [AnimBehavior.repeat] wraps the time into the key range.
+class AnimationSampler {
+  /// Creates a sampler for [animation] that writes transforms in [layout].
+  ///
+  /// Pass the [root] node of the scene to resolve [AnimBehavior.defaults]
+  /// to the transformations of the animated nodes.
+  AnimationSampler(Animation animation,
+      {this.layout = SampleLayout.trs, Node? root})
+      : ticksPerSecond = animation.ticksPerSecond != 0
+            ? animation.ticksPerSecond
+            : 25.0,
+        duration = animation.duration {
+    final native = animation.ptr.ref;
+    for (var i = 0; i < native.mNumChannels; ++i) {
+      _channels.add(_Channel(native.mChannels[i].ref));
+    }
+    channelNames =
+        List.unmodifiable(_channels.map((channel) => channel.name));
+    _defaults = Float32List(_channels.length * 10);
+    for (var i = 0; i < _channels.length; ++i) {
+      _defaults.setAll(i * 10, _identity);
+    }
+    if (root != null) _resolveDefaults(root);
+  }
+
+  /// The layout of the sampled transforms.
+  final SampleLayout layout;
+
+  /// The number of ticks per second, defaulting to 25 if the animation does
+  /// not specify it.
+  final double ticksPerSecond;
+
+  /// The duration of the animation, in ticks.
+  final double duration;
+
+  /// The names of the animated nodes, in output order.
+  late final List<String> channelNames;
+
+  final _channels = <_Channel>[];
+  late final Float32List _defaults;
+  final _trs = Float32List(10);
+
+  static const _identity = [0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0];
+
+  /// The number of animated channels.
+  int get channelCount => _channels.length;
+
+  /// The number of floats written per channel.
+  int get stride => layout == SampleLayout.trs ? 10 : 16;
+
+  /// Evaluates all channels at [time], in ticks.
+  ///
+  /// Writes [stride] floats per channel into [output], which is allocated if
+  /// not given, and returns it.
+  Float32List sample(double time, [Float32List? output]) {
+    output ??= Float32List(_channels.length * stride);
+    if (output.length < _channels.length * stride) {
+      throw ArgumentError.value(output, 'output', 'Too small');
+    }
+    final trs = layout == SampleLayout.trs;
+    for (var i = 0; i < _channels.length; ++i) {
+      final channel = _channels[i];
+      final target = trs ? output : _trs;
+      final offset = trs ? i * 10 : 0;
+      final defaults = i * 10;
+      channel.position
+          .sampleVector(time, channel, _defaults, defaults, target, offset);
+      channel.rotation.sampleRotation(
+          time, channel, _defaults, defaults + 3, target, offset + 3);
+      channel.scaling.sampleVector(
+          time, channel, _defaults, defaults + 7, target, offset + 7);
+      if (!trs) _compose(_trs, output, i * 16);
+    }
+    return output;
+  }
+
+  /// Evaluates all channels at [seconds], see [sample].
+  Float32List sampleSeconds(double seconds, [Float32List? output]) {
+    return sample(seconds * ticksPerSecond, output);
+  }
+
+  /// Forgets the cached key intervals, for example after seeking.
+  ///
+  /// Calling this is never required for correctness.
+  void reset() {
+    for (final channel in _channels) {
+      channel.position.cursor = 0;
+      channel.rotation.cursor = 0;
+      channel.scaling.cursor = 0;
+    }
+  }
+
+  void _resolveDefaults(Node root) {
+    final indices = <String, int>{};
+    for (var i = 0; i < channelNames.length; ++i) {
+      indices[channelNames[i]] = i;
+    }
+    final matrix = Matrix4.zero();
+    final translation = Vector3.zero();
+    final rotation = Quaternion.identity();
+    final scale = Vector3.zero();
+    final stack = [root];
+    while (stack.isNotEmpty) {
+      final node = stack.removeLast();
+      final index = indices.remove(node.name);
+      if (index != null) {
+        node.ptr.ref.mTransformation.copyIntoStorage(matrix.storage);
+        matrix.decompose(translation, rotation, scale);
+        final o = index * 10;
+        _defaults.setAll(o, translation.storage);
+        _defaults.setAll(o + 3, rotation.storage);
+        _defaults.setAll(o + 7, scale.storage);
+        _channels[index].hasDefaults = true;
+        if (indices.isEmpty) break;
+      }
+      stack.addAll(node.children);
+    }
+  }
+
+  // Writes the column-major matrix of the TRS in [trs] to [out] at [o].
+  static void _compose(Float32List trs, Float32List out, int o) {
+    final x = trs[3], y = trs[4], z = trs[5], w = trs[6];
+    final sx = trs[7], sy = trs[8], sz = trs[9];
+    final x2 = x + x, y2 = y + y, z2 = z + z;
+    final xx = x * x2, xy = x * y2, xz = x * z2;
+    final yy = y * y2, yz = y * z2, zz = z * z2;
+    final wx = w * x2, wy = w * y2, wz = w * z2;
+    out[o + 0] = (1 - (yy + zz)) * sx;
+    out[o + 1] = (xy + wz) * sx;
+    out[o + 2] = (xz - wy) * sx;
+    out[o + 3] = 0;
+    out[o + 4] = (xy - wz) * sy;
+    out[o + 5] = (1 - (xx + zz)) * sy;
+    out[o + 6] = (yz + wx) * sy;
+    out[o + 7] = 0;
+    out[o + 8] = (xz + wy) * sz;
+    out[o + 9] = (yz - wx) * sz;
+    out[o + 10] = (1 - (xx + yy)) * sz;
+    out[o + 11] = 0;
+    out[o + 12] = trs[0];
+    out[o + 13] = trs[1];
+    out[o + 14] = trs[2];
+    out[o + 15] = 1;
+  }
+}
+
+class _Channel {
+  final String name;
+  final AnimBehavior preState;
+  final AnimBehavior postState;
+  final _Track position;
+  final _Track rotation;
+  final _Track scaling;
+  bool hasDefaults = false;
+
+  _Channel(aiNodeAnim anim)
+      : name = AssimpString.fromNative(anim.mNodeName),
+        preState = AnimBehavior.values[anim.mPreState],
+        postState = AnimBehavior.values[anim.mPostState],
+        position = _Track(anim.mPositionKeys.cast(), anim.mNumPositionKeys,
+            sizeOf<aiVectorKey>()),
+        rotation = _Track(anim.mRotationKeys.cast(), anim.mNumRotationKeys,
+            sizeOf<aiQuatKey>()),
+        scaling = _Track(anim.mScalingKeys.cast(), anim.mNumScalingKeys,
+            sizeOf<aiVectorKey>());
+}
+
+// A key track. Each key of [keySize] bytes is a double time followed by 3
+// floats (x, y, z) or 4 floats (w, x, y, z), and possibly padding.
+class _Track {
+  final int count;
+  // The key size in doubles and in floats.
+  final int _doubles;
+  final int _floats;
+  final Float64List times;
+  final Float32List values;
+  int cursor = 0;
+
+  _Track(Pointer<Void> keys, this.count, int keySize)
+      : _doubles = keySize ~/ 8,
+        _floats = keySize ~/ 4,
+        times = count > 0
+            ? keys.cast<Double>().asTypedList(count * keySize ~/ 8)
+            : Float64List(0),
+        values = count > 0
+            ? keys.cast<Float>().asTypedList(count * keySize ~/ 4)
+            : Float32List(0);
+
+  double time(int key) => times[key * _doubles];
+
+  // Returns the key k such that time(k) <= t < time(k + 1), for a t within
+  // the key range of a track with at least two keys.
+  int find(double t) {
+    final k = cursor;
+    if (k < count - 1 && time(k) <= t) {
+      if (t < time(k + 1)) return k;
+      if (k < count - 2 && t < time(k + 2)) return cursor = k + 1;
+    }
+    var lo = 0;
+    var hi = count - 1;
+    while (hi - lo > 1) {
+      final mid = (lo + hi) >> 1;
+      if (time(mid) <= t) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    return cursor = lo;
+  }
+
+  // Maps [t] outside the key range to a key-range time for repeat, or
+  // returns null if [behavior] does not resample the track.
+  double? _wrap(double t, AnimBehavior behavior) {
+    if (behavior != AnimBehavior.repeat) return null;
+    final start = time(0);
+    final length = time(count - 1) - start;
+    if (length <= 0) return null;
+    return start + (t - start) % length;
+  }
+
+  void sampleVector(double t, _Channel channel, Float32List defaults, int d,
+      Float32List out, int o) {
+    if (count == 0) {
+      _copy(defaults, d, out, o, 3);
+      return;
+    }
+    if (count > 1 && (t < time(0) || t > time(count - 1))) {
+      final before = t < time(0);
+      final behavior = before ? channel.preState : channel.postState;
+      final wrapped = _wrap(t, behavior);
+      if (wrapped != null) {
+        t = wrapped;
+      } else if (behavior == AnimBehavior.linear) {
+        final k = before ? 0 : count - 2;
+        _lerp(k, (t - time(k)) / (time(k + 1) - time(k)), out, o);
+        return;
+      } else if (behavior == AnimBehavior.defaults && channel.hasDefaults) {
+        _copy(defaults, d, out, o, 3);
+        return;
+      } else {
+        _copy(values, (before ? 0 : count - 1) * _floats + 2, out, o, 3);
+        return;
+      }
+    }
+    if (count == 1 || t <= time(0)) {
+      _copy(values, 2, out, o, 3);
+    } else if (t >= time(count - 1)) {
+      _copy(values, (count - 1) * _floats + 2, out, o, 3);
+    } else {
+      final k = find(t);
+      final span = time(k + 1) - time(k);
+      _lerp(k, span > 0 ? (t - time(k)) / span : 0.0, out, o);
+    }
+  }
+
+  void sampleRotation(double t, _Channel channel, Float32List defaults, int d,
+      Float32List out, int o) {
+    if (count == 0) {
+      _copy(defaults, d, out, o, 4);
+      return;
+    }
+    if (count > 1 && (t < time(0) || t > time(count - 1))) {
+      final before = t < time(0);
+      final behavior = before ? channel.preState : channel.postState;
+      final wrapped = _wrap(t, behavior);
+      if (wrapped != null) {
+        t = wrapped;
+      } else if (behavior == AnimBehavior.defaults && channel.hasDefaults) {
+        _copy(defaults, d, out, o, 4);
+        return;
+      } else {
+        _rotation(before ? 0 : count - 1, out, o);
+        return;
+      }
+    }
+    if (count == 1 || t <= time(0)) {
+      _rotation(0, out, o);
+    } else if (t >= time(count - 1)) {
+      _rotation(count - 1, out, o);
+    } else {
+      final k = find(t);
+      final span = time(k + 1) - time(k);
+      _slerp(k, span > 0 ? (t - time(k)) / span : 0.0, out, o);
+    }
+  }
+
+  static void _copy(Float32List src, int s, Float32List dst, int d, int n) {
+    for (var i = 0; i < n; ++i) {
+      dst[d + i] = src[s + i];
+    }
+  }
+
+  void _lerp(int k, double f, Float32List out, int o) {
+    final a = k * _floats + 2;
+    final b = a + _floats;
+    out[o] = values[a] + (values[b] - values[a]) * f;
+    out[o + 1] = values[a + 1] + (values[b + 1] - values[a + 1]) * f;
+    out[o + 2] = values[a + 2] + (values[b + 2] - values[a + 2]) * f;
+  }
+
+  // Writes key [k] as (x, y, z, w).
+  void _rotation(int k, Float32List out, int o) {
+    final a = k * _floats + 2;
+    out[o] = values[a + 1];
+    out[o + 1] = values[a + 2];
+    out[o + 2] = values[a + 3];
+    out[o + 3] = values[a];
+  }
+
+  void _slerp(int k, double f, Float32List out, int o) {
+    final a = k * _floats + 2;
+    final b = a + _floats;
+    final aw = values[a], ax = values[a + 1];
+    final ay = values[a + 2], az = values[a + 3];
+    var bw = values[b], bx = values[b + 1];
+    var by = values[b + 2], bz = values[b + 3];
+    var cos = aw * bw + ax * bx + ay * by + az * bz;
+    if (cos < 0) {
+      cos = -cos;
+      bw = -bw;
+      bx = -bx;
+      by = -by;
+      bz = -bz;
+    }
+    double sa, sb;
+    if (1 - cos > 1e-6) {
+      final omega = math.acos(cos);
+      final sin = math.sin(omega);
+      sa = math.sin((1 - f) * omega) / sin;
+      sb = math.sin(f * omega) / sin;
+    } else {
+      sa = 1 - f;
+      sb = f;
+    }
+    final w = sa * aw + sb * bw;
+    final x = sa * ax + sb * bx;
+    final y = sa * ay + sb * by;
+    final z = sa * az + sb * bz;
+    final length = math.sqrt(w * w + x * x + y * y + z * z);
+    final inv = length > 0 ? 1 / length : 1.0;
+    out[o] = x * inv;
+    out[o + 1] = y * inv;
+    out[o + 2] = z * inv;
+    out[o + 3] = w * inv;
+  }
+}
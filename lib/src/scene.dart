@@ -49,14 +49,26 @@ import 'package:ffi/ffi.dart';
 
 import 'animation.dart';
 import 'bindings.dart';
+import 'bvh.dart';
+import 'cached.dart';
 import 'camera.dart';
 import 'extensions.dart';
+import 'filesystem.dart';
+import 'hierarchy.dart';
 import 'libassimp.dart';
+import 'lookup.dart';
 import 'light.dart';
+import 'logstream.dart';
 import 'material.dart';
+import 'mattable.dart';
 import 'mesh.dart';
 import 'metadata.dart';
+import 'mmap.dart';
 import 'node.dart';
+import 'pool.dart';
+import 'prefetch.dart';
+import 'profile.dart';
+import 'simplify.dart';
 import 'texture.dart';
 import 'type.dart';
 
@@ -137,24 +149,32 @@ class Scene extends AssimpType<aiScene> {
   ///   a successful import. Provide a bitwise combination of the
   ///   #aiPostProcessSteps flags.
   /// @return Pointer to the imported data or NULL if the import failed.
+  ///
+  /// If a [fileSystem] is given, the model file and any files it references
+  /// are read from it instead of the disk.
   static Scene? fromFile(String path,
-      {int flags = 0, Map<String, dynamic>? properties}) {
+      {int flags = 0,
+      Map<String, dynamic>? properties,
+      FileSystem? fileSystem}) {
     final cpath = path.toNativeString();
     final store = PropertyStore.fromMap(properties);
+    final io = fileSystem != null
+        ? FileSystemBridge.allocate(fileSystem)
+        : nullptr.cast<aiFileIO>();
     final ptr = libassimp.aiImportFileExWithProperties(
-        cpath, flags, nullptr, store?.ptr ?? nullptr);
+        cpath, flags, io, store?.ptr ?? nullptr);
+    if (fileSystem != null) FileSystemBridge.free(io);
     malloc.free(cpath);
     store?.dispose();
     return Scene.fromNative(ptr);
   }
 
-  static Scene? _fromBuffer(Pointer<Int8> cstr, int length, flags,
+  static Scene? _fromBuffer(Pointer<Int8> cbuffer, int length, int flags,
       Map<String, dynamic>? properties, String hint) {
     final chint = hint.toNativeString();
     final store = PropertyStore.fromMap(properties);
     final ptr = libassimp.aiImportFileFromMemoryWithProperties(
-        cstr, length, flags, chint, store?.ptr ?? nullptr);
-    malloc.free(cstr);
+        cbuffer, length, flags, chint, store?.ptr ?? nullptr);
     malloc.free(chint);
     store?.dispose();
     return Scene.fromNative(ptr);
@@ -165,8 +185,11 @@ class Scene extends AssimpType<aiScene> {
   /// @{macro assimp.scene.import}
   static Scene? fromString(String str,
       {int flags = 0, Map<String, dynamic>? properties, String hint = ''}) {
-    return Scene._fromBuffer(
-        str.toNativeString(), str.length, flags, properties, hint);
+    final cstr = str.toNativeUtf8();
+    final scene = Scene._fromBuffer(
+        cstr.cast<Int8>(), cstr.length, flags, properties, hint);
+    malloc.free(cstr);
+    return scene;
   }
 
   /// Reads the given file from a given memory buffer.
@@ -200,15 +223,116 @@ class Scene extends AssimpType<aiScene> {
   /// a custom IOSystem to make Assimp find these files and use
   /// the regular aiImportFileEx()/aiImportFileExWithProperties() API.
   /// @{endtemplate assimp.scene.import}
+  ///
+  /// **Note:** The bytes are copied to native memory before importing,
+  /// because a Dart list cannot be passed to native code as is. Use
+  /// [fromNativeBuffer] or [fromMappedFile] to import large files without
+  /// the extra copy.
   static Scene? fromBytes(Uint8List bytes,
       {int flags = 0, Map<String, dynamic>? properties, String hint = ''}) {
-    // ### TODO: avoid copy...
-    // https://github.com/dart-lang/ffi/issues/31
-    // https://github.com/dart-lang/ffi/issues/27
-    final cbuffer = malloc<Int8>(bytes.length);
-    final carray = cbuffer.asTypedList(bytes.length);
-    carray.setAll(0, bytes);
-    return Scene._fromBuffer(cbuffer, bytes.length, flags, properties, hint);
+    final cbuffer = malloc<Uint8>(bytes.length);
+    cbuffer.asTypedList(bytes.length).setAll(0, bytes);
+    final scene = Scene._fromBuffer(
+        cbuffer.cast<Int8>(), bytes.length, flags, properties, hint);
+    malloc.free(cbuffer);
+    return scene;
+  }
+
+  /// Reads the given file from an existing native memory buffer.
+  ///
+  /// The [length] bytes at [buffer] are passed to Assimp as is, without
+  /// copying. The buffer stays owned by the caller and may be released or
+  /// reused as soon as this call returns, because the imported scene does
+  /// not refer to it.
+  ///
+  /// @{macro assimp.scene.import}
+  static Scene? fromNativeBuffer(Pointer<Uint8> buffer, int length,
+      {int flags = 0, Map<String, dynamic>? properties, String hint = ''}) {
+    return Scene._fromBuffer(
+        buffer.cast<Int8>(), length, flags, properties, hint);
+  }
+
+  /// Reads the given file by mapping it into memory.
+  ///
+  /// The file is memory-mapped and imported straight from the mapping, so
+  /// its contents are never copied into the Dart heap. The mapping is
+  /// released before this call returns. The [hint] defaults to the file
+  /// extension of [path].
+  ///
+  /// Unlike [fromFile], files referenced by the model (e.g. OBJ materials)
+  /// are not resolved.
+  ///
+  /// Throws a [FileSystemException] if the file cannot be mapped.
+  static Scene? fromMappedFile(String path,
+      {int flags = 0, Map<String, dynamic>? properties, String? hint}) {
+    final file = MappedFile.open(path);
+    final scene = Scene.fromNativeBuffer(file.data, file.length,
+        flags: flags,
+        properties: properties,
+        hint: hint ?? _extension(path));
+    file.dispose();
+    return scene;
+  }
+
+  /// The export format of scene snapshots, see [SceneExport.saveSnapshot].
+  static const snapshotFormat = 'assbin';
+
+  static const _snapshotMagic = 'ASSIMP.binary-dump.';
+
+  /// Reads a scene snapshot written by [SceneExport.saveSnapshot].
+  ///
+  /// The snapshot is memory-mapped and loaded without running the original
+  /// importer or any post-processing steps again, which makes it much
+  /// faster than importing the source file. The [flags] are applied on top
+  /// of the post-processing that was baked into the snapshot.
+  ///
+  /// Throws a [FormatException] if [path] is not a snapshot, or a
+  /// [FileSystemException] if it cannot be mapped.
+  static Scene? fromSnapshot(String path, {int flags = 0}) {
+    final file = MappedFile.open(path);
+    try {
+      if (!isSnapshot(file.data.asTypedList(file.length))) {
+        throw FormatException('Not a scene snapshot', path);
+      }
+      return Scene.fromNativeBuffer(file.data, file.length,
+          flags: flags, hint: snapshotFormat);
+    } finally {
+      file.dispose();
+    }
+  }
+
+  /// Whether [bytes] start with a scene snapshot header.
+  static bool isSnapshot(Uint8List bytes) {
+    if (bytes.length < _snapshotMagic.length) return false;
+    for (var i = 0; i < _snapshotMagic.length; ++i) {
+      if (bytes[i] != _snapshotMagic.codeUnitAt(i)) return false;
+    }
+    return true;
+  }
+
+  static String _extension(String path) {
+    final dot = path.lastIndexOf('.');
+    if (dot < 0 || dot < path.lastIndexOf(RegExp(r'[/\\]'))) return '';
+    return path.substring(dot + 1);
+  }
+
+  /// Reads the given file on a background isolate.
+  ///
+  /// The native import runs on a worker of [pool], or [ImportPool.shared]
+  /// if no pool is given, so the calling isolate is not blocked while a
+  /// large file is being imported. Completes with the imported scene, or
+  /// with an [ImportException] carrying [Assimp.errorString] if the import
+  /// fails. Pass a [cancelToken] to abandon the import; see [CancelToken].
+  /// Fails with a [StateError] while a [LogStream] is attached.
+  ///
+  /// See [fromFile] for the meaning of [flags] and [properties].
+  static Future<Scene> importAsync(String path,
+      {int flags = 0,
+      Map<String, dynamic>? properties,
+      ImportPool? pool,
+      CancelToken? cancelToken}) {
+    return (pool ?? ImportPool.shared).importFile(path,
+        flags: flags, properties: properties, cancelToken: cancelToken);
   }
 
   /// Create a modifiable copy of a scene.
@@ -240,6 +364,15 @@ class Scene extends AssimpType<aiScene> {
   /// of the imported file.
   Node get rootNode => Node.fromNative(_scene.mRootNode)!;
 
+  /// Flattens the node hierarchy into arrays with precomputed world
+  /// transformations, see [FlatHierarchy].
+  FlatHierarchy flattenHierarchy() => FlatHierarchy.fromNode(rootNode);
+
+  /// Builds a spatial index over the mesh instances, see [SceneBvh].
+  SceneBvh buildBvh({bool triangles = false}) {
+    return SceneBvh.fromScene(this, triangles: triangles);
+  }
+
   /// The array of meshes.
   ///
   /// Use the indices given in the [Node] structure to access this array.
@@ -252,6 +385,18 @@ class Scene extends AssimpType<aiScene> {
     );
   }
 
+  /// Generates a level of detail of every mesh for each of the triangle
+  /// [ratios], see [MeshSimplify.simplify].
+  ///
+  /// Returns the levels of each mesh in the order of [meshes] and [ratios].
+  List<List<MeshLod>> generateLods(List<double> ratios,
+      {double errorBound = 0.01}) {
+    return [
+      for (final mesh in meshes)
+        [for (final ratio in ratios) mesh.simplify(ratio, errorBound)]
+    ];
+  }
+
   /// The array of materials.
   ///
   /// Use the index given in each [Mesh] structure to access this array.
@@ -264,6 +409,10 @@ class Scene extends AssimpType<aiScene> {
     );
   }
 
+  /// Deduplicates the materials into a packed GPU material table, see
+  /// [MaterialTable].
+  MaterialTable buildMaterialTable() => MaterialTable.fromScene(this);
+
   /// The array of animations.
   ///
   /// All animations imported from the given file are listed here.
@@ -286,6 +435,14 @@ class Scene extends AssimpType<aiScene> {
     );
   }
 
+  /// Collects the textures referenced by the materials, resolved relative
+  /// to [modelPath], see [TextureDependency.collect].
+  ///
+  /// Pass the result to a [TexturePrefetcher] to start reading the files.
+  List<TextureDependency> textureDependencies(String modelPath) {
+    return TextureDependency.collect(this, modelPath);
+  }
+
   /// The array of light sources.
   ///
   /// All light sources imported from the given file are listed here.
@@ -316,6 +473,20 @@ class Scene extends AssimpType<aiScene> {
   /// can be used to store format-specific metadata as well.
   MetaData? get metaData => MetaData.fromNative(_scene.mMetaData);
 
+  /// A cached view of this scene, see [CachedScene].
+  ///
+  /// The view is created on first access and shared by later calls on
+  /// this object.
+  CachedScene cached() => _cached;
+
+  late final CachedScene _cached = CachedScene(this);
+
+  /// Name-indexed lookups between nodes, bones and animation channels.
+  ///
+  /// The index is built on first access and rebuilt after the scene is
+  /// post-processed. Setting node transformations keeps it.
+  SceneIndex get index => _cached.index;
+
   /// Post-process a scene.
   ///
   /// This is strictly equivalent to calling #aiImportFile()/#aiImportFileEx with the
@@ -329,11 +500,35 @@ class Scene extends AssimpType<aiScene> {
   ///   case, post processing steps are not really designed to 'fail'. To be exact,
   ///   the #aiProcess_ValidateDataStructure flag is currently the only post processing step
   ///   which can actually cause the scene to be reset to NULL.
-  void postProcess(int flags) => libassimp.aiApplyPostProcessing(ptr, flags);
+  void postProcess(int flags) {
+    Material.release(ptr);
+    libassimp.aiApplyPostProcessing(ptr, flags);
+    CachedScene.markTopologyChanged(ptr);
+  }
+
+  /// Post-processes the scene one step at a time and reports the cost of
+  /// each step.
+  ///
+  /// The steps selected by [flags] are applied in the order of Assimp's
+  /// post-processing pipeline, recording the wall time, vertex and face
+  /// counts, and [MemoryInfo] totals around each step. The result is close
+  /// to, but not always identical with, [postProcess] with the same flags,
+  /// because Assimp shares some intermediate data between steps of a
+  /// single run.
+  ///
+  /// If a step fails, Assimp releases the scene; the report then ends with
+  /// a failed step and the scene must not be used anymore.
+  ProcessReport profilePostProcess(int flags) {
+    return ProcessReport.run(this, flags);
+  }
 
   /// Releases all resources associated with the given import process.
   ///
   /// Call this function after you're done with the imported data.
   /// @param pScene The imported data to release. NULL is a valid value.
-  void dispose() => libassimp.aiReleaseImport(ptr);
+  void dispose() {
+    CachedScene.release(ptr);
+    Material.release(ptr);
+    libassimp.aiReleaseImport(ptr);
+  }
 }
@@ -0,0 +1,459 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'mesh.dart';
+
+/// A level of detail of a mesh, with its own vertex and index buffers.
+class MeshLod {
+  MeshLod._(this.positions, this.normals, this.uvs, this.uvComponents,
+      this.indices, this.remap, this.error);
+
+  /// The vertex positions, three floats per vertex.
+  final Float32List positions;
+
+  /// The vertex normals, three floats per vertex, if the mesh has normals.
+  final Float32List? normals;
+
+  /// The texture coordinates of the first UV channel, [uvComponents]
+  /// floats per vertex, if the mesh has texture coordinates.
+  final Float32List? uvs;
+
+  /// The number of floats per vertex in [uvs].
+  final int uvComponents;
+
+  /// The triangle indices, three per triangle.
+  final Uint32List indices;
+
+  /// The index of each vertex in the source mesh.
+  ///
+  /// Use it to carry over other vertex streams, such as colors or skin
+  /// weights.
+  final Uint32List remap;
+
+  /// The largest error introduced by the simplification, relative to the
+  /// extent of the mesh.
+  final double error;
+
+  /// The number of vertices.
+  int get vertexCount => positions.length ~/ 3;
+
+  /// The number of triangles.
+  int get triangleCount => indices.length ~/ 3;
+}
+
+/// Simplifies triangle meshes by quadric error edge collapse.
+///
+/// Each vertex accumulates the area weighted plane quadrics of its
+/// triangles, and edges are collapsed onto one of their endpoints in order
+/// of the quadric error, plus a penalty for the normal and UV difference
+/// of the endpoints. Collapses that flip a triangle are rejected.
+///
+/// Vertices on open borders, and vertices on attribute seams (positions
+/// shared by vertices with different normals or UVs), are never moved, so
+/// silhouettes, material boundaries and UV seams are preserved. Since
+/// Assimp splits meshes by material, every material boundary is a border.
+class MeshSimplifier {
+  /// The weight of the attribute penalty relative to the geometric error.
+  static const double attributeWeight = 0.05;
+
+  /// Simplifies the triangle list given by [indices] into [positions] down
+  /// to [targetRatio] of the triangle count, without exceeding
+  /// [errorBound], a distance relative to the extent of the mesh.
+  ///
+  /// The result may have more triangles than requested if the error bound
+  /// or the locked vertices prevent further collapses.
+  static MeshLod simplify(Float32List positions, Uint32List indices,
+      {Float32List? normals,
+      Float32List? uvs,
+      int uvComponents = 2,
+      double targetRatio = 0.5,
+      double errorBound = 0.01}) {
+    final vertexCount = positions.length ~/ 3;
+    final uvSize = uvs == null ? 0 : uvComponents;
+
+    // weld vertices that only differ in their index
+    final keys = List<int>.generate(vertexCount, (i) => i);
+    int compare(int a, int b, bool attributes) {
+      for (var k = 0; k < 3; ++k) {
+        final d = positions[a * 3 + k].compareTo(positions[b * 3 + k]);
+        if (d != 0) return d;
+      }
+      if (!attributes) return 0;
+      if (normals != null) {
+        for (var k = 0; k < 3; ++k) {
+          final d = normals[a * 3 + k].compareTo(normals[b * 3 + k]);
+          if (d != 0) return d;
+        }
+      }
+      for (var k = 0; k < uvSize; ++k) {
+        final d = uvs![a * uvSize + k].compareTo(uvs[b * uvSize + k]);
+        if (d != 0) return d;
+      }
+      return 0;
+    }
+
+    keys.sort((a, b) => compare(a, b, true));
+    final wedge = Uint32List(vertexCount);
+    final position = Uint32List(vertexCount);
+    final locked = Uint8List(vertexCount);
+    var positionCount = 0;
+    for (var i = 0; i < vertexCount;) {
+      var j = i + 1;
+      while (j < vertexCount && compare(keys[i], keys[j], false) == 0) {
+        ++j;
+      }
+      // keys[i..j) share a position
+      var wedges = 0;
+      for (var k = i; k < j; ++k) {
+        final v = keys[k];
+        if (k == i || compare(keys[k - 1], v, true) != 0) {
+          wedge[v] = v;
+          ++wedges;
+        } else {
+          wedge[v] = wedge[keys[k - 1]];
+        }
+        position[v] = positionCount;
+      }
+      if (wedges > 1) {
+        for (var k = i; k < j; ++k) {
+          locked[keys[k]] = 1;
+        }
+      }
+      ++positionCount;
+      i = j;
+    }
+
+    var current = Uint32List(indices.length);
+    var triangleCount = 0;
+    for (var t = 0; t + 2 < indices.length; t += 3) {
+      final a = wedge[indices[t]];
+      final b = wedge[indices[t + 1]];
+      final c = wedge[indices[t + 2]];
+      if (a == b || b == c || c == a) continue;
+      current[triangleCount * 3] = a;
+      current[triangleCount * 3 + 1] = b;
+      current[triangleCount * 3 + 2] = c;
+      ++triangleCount;
+    }
+
+    // lock the vertices of edges that belong to a single triangle
+    final edges = <int, int>{};
+    int edgeKey(int a, int b) {
+      final pa = position[a], pb = position[b];
+      return pa < pb ? pa * positionCount + pb : pb * positionCount + pa;
+    }
+
+    for (var i = 0; i < triangleCount * 3; ++i) {
+      final a = current[i];
+      final b = current[i % 3 == 2 ? i - 2 : i + 1];
+      final key = edgeKey(a, b);
+      edges[key] = (edges[key] ?? 0) + 1;
+    }
+    for (var i = 0; i < triangleCount * 3; ++i) {
+      final a = current[i];
+      final b = current[i % 3 == 2 ? i - 2 : i + 1];
+      if (edges[edgeKey(a, b)] == 1) {
+        locked[a] = 1;
+        locked[b] = 1;
+      }
+    }
+
+    var minX = double.infinity, minY = double.infinity;
+    var minZ = double.infinity;
+    var maxX = -double.infinity, maxY = -double.infinity;
+    var maxZ = -double.infinity;
+    for (var i = 0; i < positions.length; i += 3) {
+      minX = math.min(minX, positions[i]);
+      minY = math.min(minY, positions[i + 1]);
+      minZ = math.min(minZ, positions[i + 2]);
+      maxX = math.max(maxX, positions[i]);
+      maxY = math.max(maxY, positions[i + 1]);
+      maxZ = math.max(maxZ, positions[i + 2]);
+    }
+    final extent = vertexCount == 0
+        ? 1.0
+        : math.max(math.max(maxX - minX, maxY - minY), maxZ - minZ);
+    final scale = extent > 0 ? 1 / extent : 1.0;
+
+    // quadrics per position: 10 coefficients and the accumulated weight
+    final quadrics = Float64List(positionCount * 11);
+    for (var t = 0; t < triangleCount; ++t) {
+      final a = current[t * 3], b = current[t * 3 + 1], c = current[t * 3 + 2];
+      final ax = positions[a * 3] * scale, ay = positions[a * 3 + 1] * scale;
+      final az = positions[a * 3 + 2] * scale;
+      final e1x = positions[b * 3] * scale - ax;
+      final e1y = positions[b * 3 + 1] * scale - ay;
+      final e1z = positions[b * 3 + 2] * scale - az;
+      final e2x = positions[c * 3] * scale - ax;
+      final e2y = positions[c * 3 + 1] * scale - ay;
+      final e2z = positions[c * 3 + 2] * scale - az;
+      var nx = e1y * e2z - e1z * e2y;
+      var ny = e1z * e2x - e1x * e2z;
+      var nz = e1x * e2y - e1y * e2x;
+      final length = math.sqrt(nx * nx + ny * ny + nz * nz);
+      if (length == 0) continue;
+      final area = length / 2;
+      nx /= length;
+      ny /= length;
+      nz /= length;
+      final d = -(nx * ax + ny * ay + nz * az);
+      for (final v in [a, b, c]) {
+        final q = position[v] * 11;
+        quadrics[q] += area * nx * nx;
+        quadrics[q + 1] += area * nx * ny;
+        quadrics[q + 2] += area * nx * nz;
+        quadrics[q + 3] += area * nx * d;
+        quadrics[q + 4] += area * ny * ny;
+        quadrics[q + 5] += area * ny * nz;
+        quadrics[q + 6] += area * ny * d;
+        quadrics[q + 7] += area * nz * nz;
+        quadrics[q + 8] += area * nz * d;
+        quadrics[q + 9] += area * d * d;
+        quadrics[q + 10] += area;
+      }
+    }
+
+    double cost(int from, int to) {
+      final q = position[from] * 11;
+      final x = positions[to * 3] * scale, y = positions[to * 3 + 1] * scale;
+      final z = positions[to * 3 + 2] * scale;
+      var error = quadrics[q] * x * x +
+          2 * quadrics[q + 1] * x * y +
+          2 * quadrics[q + 2] * x * z +
+          2 * quadrics[q + 3] * x +
+          quadrics[q + 4] * y * y +
+          2 * quadrics[q + 5] * y * z +
+          2 * quadrics[q + 6] * y +
+          quadrics[q + 7] * z * z +
+          2 * quadrics[q + 8] * z +
+          quadrics[q + 9];
+      final weight = quadrics[q + 10];
+      error = weight > 0 ? math.max(0.0, error / weight) : 0.0;
+      var attributes = 0.0;
+      if (normals != null) {
+        for (var k = 0; k < 3; ++k) {
+          final d = normals[from * 3 + k] - normals[to * 3 + k];
+          attributes += d * d / 4;
+        }
+      }
+      for (var k = 0; k < uvSize; ++k) {
+        final d = uvs![from * uvSize + k] - uvs[to * uvSize + k];
+        attributes += d * d;
+      }
+      return error + attributes * attributeWeight * attributeWeight;
+    }
+
+    // true if moving [from] to [to] flips a triangle around [from]
+    bool flips(int from, int to, Uint32List offsets, Uint32List adjacency) {
+      for (var i = offsets[from]; i < offsets[from + 1]; ++i) {
+        final t = adjacency[i] * 3;
+        final a = current[t], b = current[t + 1], c = current[t + 2];
+        if (a == to || b == to || c == to) continue;
+        final before = _normal(positions, a, b, c);
+        final after = _normal(positions, a == from ? to : a,
+            b == from ? to : b, c == from ? to : c);
+        if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2]
+            <= 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    final target = (triangleCount * targetRatio.clamp(0.0, 1.0)).round();
+    final bound = errorBound * errorBound;
+    final collapse = Uint32List(vertexCount);
+    final touched = Uint8List(vertexCount);
+    var maxError = 0.0;
+    while (triangleCount > target) {
+      // vertex to triangle adjacency
+      final offsets = Uint32List(vertexCount + 1);
+      for (var i = 0; i < triangleCount * 3; ++i) {
+        ++offsets[current[i] + 1];
+      }
+      for (var v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] += offsets[v];
+      }
+      final fill = Uint32List.fromList(offsets);
+      final adjacency = Uint32List(triangleCount * 3);
+      for (var i = 0; i < triangleCount * 3; ++i) {
+        adjacency[fill[current[i]]++] = i ~/ 3;
+      }
+
+      // the cheapest direction of every edge
+      final candidateFrom = <int>[];
+      final candidateTo = <int>[];
+      final candidateCost = <double>[];
+      for (var i = 0; i < triangleCount * 3; ++i) {
+        final a = current[i];
+        final b = current[i % 3 == 2 ? i - 2 : i + 1];
+        // visit each undirected edge once
+        if (a > b && _hasEdge(current, offsets, adjacency, b, a)) continue;
+        final ab = locked[a] == 0 ? cost(a, b) : double.infinity;
+        final ba = locked[b] == 0 ? cost(b, a) : double.infinity;
+        final best = math.min(ab, ba);
+        if (best > bound) continue;
+        candidateFrom.add(ab <= ba ? a : b);
+        candidateTo.add(ab <= ba ? b : a);
+        candidateCost.add(best);
+      }
+      if (candidateFrom.isEmpty) break;
+      final order = List<int>.generate(candidateFrom.length, (i) => i)
+        ..sort((a, b) => candidateCost[a].compareTo(candidateCost[b]));
+
+      for (var v = 0; v < vertexCount; ++v) {
+        collapse[v] = v;
+      }
+      touched.fillRange(0, vertexCount, 0);
+      var remaining = triangleCount;
+      var collapsed = 0;
+      for (final c in order) {
+        if (remaining <= target) break;
+        final from = candidateFrom[c], to = candidateTo[c];
+        if (touched[from] != 0 || touched[to] != 0) continue;
+        if (flips(from, to, offsets, adjacency)) continue;
+        collapse[from] = to;
+        maxError = math.max(maxError, candidateCost[c]);
+        for (var i = offsets[from]; i < offsets[from + 1]; ++i) {
+          final t = adjacency[i] * 3;
+          final a = current[t], b = current[t + 1], d = current[t + 2];
+          touched[a] = touched[b] = touched[d] = 1;
+          if (a == to || b == to || d == to) --remaining;
+        }
+        final qf = position[from] * 11, qt = position[to] * 11;
+        for (var k = 0; k < 11; ++k) {
+          quadrics[qt + k] += quadrics[qf + k];
+        }
+        ++collapsed;
+      }
+      if (collapsed == 0) break;
+
+      var count = 0;
+      for (var t = 0; t < triangleCount; ++t) {
+        final a = collapse[current[t * 3]];
+        final b = collapse[current[t * 3 + 1]];
+        final c = collapse[current[t * 3 + 2]];
+        if (a == b || b == c || c == a) continue;
+        current[count * 3] = a;
+        current[count * 3 + 1] = b;
+        current[count * 3 + 2] = c;
+        ++count;
+      }
+      triangleCount = count;
+    }
+
+    // compact the vertices that are still referenced
+    final newIndex = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+    final remap = <int>[];
+    final outIndices = Uint32List(triangleCount * 3);
+    for (var i = 0; i < outIndices.length; ++i) {
+      final v = current[i];
+      if (newIndex[v] < 0) {
+        newIndex[v] = remap.length;
+        remap.add(v);
+      }
+      outIndices[i] = newIndex[v];
+    }
+    final outPositions = Float32List(remap.length * 3);
+    final outNormals = normals == null ? null : Float32List(remap.length * 3);
+    final outUvs = uvs == null ? null : Float32List(remap.length * uvSize);
+    for (var i = 0; i < remap.length; ++i) {
+      final v = remap[i];
+      for (var k = 0; k < 3; ++k) {
+        outPositions[i * 3 + k] = positions[v * 3 + k];
+        outNormals?[i * 3 + k] = normals![v * 3 + k];
+      }
+      for (var k = 0; k < uvSize; ++k) {
+        outUvs![i * uvSize + k] = uvs![v * uvSize + k];
+      }
+    }
+    return MeshLod._(outPositions, outNormals, outUvs, uvSize, outIndices,
+        Uint32List.fromList(remap), math.sqrt(maxError));
+  }
+
+  static bool _hasEdge(Uint32List indices, Uint32List offsets,
+      Uint32List adjacency, int a, int b) {
+    for (var i = offsets[a]; i < offsets[a + 1]; ++i) {
+      final t = adjacency[i] * 3;
+      for (var k = 0; k < 3; ++k) {
+        if (indices[t + k] == a && indices[t + (k + 1) % 3] == b) return true;
+      }
+    }
+    return false;
+  }
+
+  static List<double> _normal(Float32List positions, int a, int b, int c) {
+    final ax = positions[a * 3], ay = positions[a * 3 + 1];
+    final az = positions[a * 3 + 2];
+    final e1x = positions[b * 3] - ax, e1y = positions[b * 3 + 1] - ay;
+    final e1z = positions[b * 3 + 2] - az;
+    final e2x = positions[c * 3] - ax, e2y = positions[c * 3 + 1] - ay;
+    final e2z = positions[c * 3 + 2] - az;
+    return [
+      e1y * e2z - e1z * e2y,
+      e1z * e2x - e1x * e2z,
+      e1x * e2y - e1y * e2x,
+    ];
+  }
+}
+
+/// Generates levels of detail for meshes.
+extension MeshSimplify on Mesh {
+  /// Simplifies this mesh to [targetRatio] of its triangles without
+  /// exceeding [errorBound], see [MeshSimplifier.simplify].
+  ///
+  /// The positions, normals and the first UV channel are carried over. Only
+  /// the triangle faces are simplified, see [Mesh.triangleIndexData].
+  MeshLod simplify(double targetRatio, [double errorBound = 0.01]) {
+    final uvs = textureCoordData(0);
+    return MeshSimplifier.simplify(vertexData, triangleIndexData,
+        normals: normalData,
+        uvs: uvs,
+        uvComponents: uvs == null ? 0 : uvComponents.first,
+        targetRatio: targetRatio,
+        errorBound: errorBound);
+  }
+}
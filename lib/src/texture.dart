@@ -41,7 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
+import 'dart:async';
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import 'bindings.dart';
 import 'extensions.dart';
@@ -107,6 +109,8 @@ class Texture extends AssimpType<aiTexture> {
   /// as possible. If mHeight = 0 this is a pointer to a memory
   /// buffer of size mWidth containing the compressed texture
   /// data. Good luck, have fun!
+  ///
+  /// Creates an object per texel; use [bytes] or [toRgba] for bulk access.
   Iterable<Texel> get data {
     return Iterable.generate(
       _texture.mWidth * _texture.mHeight,
@@ -114,6 +118,97 @@ class Texture extends AssimpType<aiTexture> {
     );
   }
 
+  /// Whether the texture is stored in a compressed file format, such as
+  /// PNG or JPEG, given by [formatHint].
+  bool get isCompressed => _texture.mHeight == 0;
+
+  /// The texture data as a view of the native memory.
+  ///
+  /// Contains the file bytes of [isCompressed] textures, and otherwise
+  /// [width] * [height] texels of four bytes in B, G, R, A order (ARGB8888
+  /// in a little endian word). The view is only valid while the scene is
+  /// alive.
+  Uint8List get bytes {
+    final length = isCompressed
+        ? _texture.mWidth
+        : _texture.mWidth * _texture.mHeight * sizeOf<aiTexel>();
+    if (length == 0) return Uint8List(0);
+    return _texture.pcData.cast<Uint8>().asTypedList(length);
+  }
+
+  /// Converts the texels of an uncompressed texture to R, G, B, A byte
+  /// order, ready for upload as an RGBA8 image.
+  ///
+  /// Writes into [out] if given, which must hold at least [width] *
+  /// [height] * 4 bytes, and returns the written bytes. Throws a
+  /// [StateError] for compressed textures.
+  Uint8List toRgba([Uint8List? out]) {
+    if (isCompressed) {
+      throw StateError('Cannot convert a compressed texture to RGBA');
+    }
+    final source = bytes;
+    final length = source.length;
+    final target =
+        out == null ? Uint8List(length) : Uint8List.sublistView(out, 0, length);
+    if (source.offsetInBytes % 4 == 0 && target.offsetInBytes % 4 == 0) {
+      final src = source.buffer.asUint32List(source.offsetInBytes, length ~/ 4);
+      final dst = target.buffer.asUint32List(target.offsetInBytes, length ~/ 4);
+      final swap = Endian.host == Endian.little;
+      for (var i = 0; i < src.length; ++i) {
+        final v = src[i];
+        dst[i] = swap
+            ? (v & 0xff00ff00) | ((v >> 16) & 0xff) | ((v & 0xff) << 16)
+            : (v & 0x00ff00ff) | ((v >> 16) & 0xff00) | ((v & 0xff00) << 16);
+      }
+    } else {
+      for (var i = 0; i < length; i += 4) {
+        target[i] = source[i + 2];
+        target[i + 1] = source[i + 1];
+        target[i + 2] = source[i];
+        target[i + 3] = source[i + 3];
+      }
+    }
+    return target;
+  }
+
+  /// Decodes [textures] with [decoder], running at most [concurrency]
+  /// decoders at a time.
+  ///
+  /// The results are returned in the order of [textures]. The decoder gets
+  /// the texture itself, so it can pick [bytes] or [toRgba] depending on
+  /// [isCompressed]. Since [bytes] views native memory, decoders that hand
+  /// the data to another isolate must copy it first, and the scene must
+  /// stay alive until the returned future completes.
+  static Future<List<T>> decodeAll<T>(
+      Iterable<Texture> textures, Future<T> Function(Texture texture) decoder,
+      {int concurrency = 4}) {
+    final list = textures.toList();
+    final results = List<T?>.filled(list.length, null);
+    final completer = Completer<List<T>>();
+    var next = 0;
+    var done = 0;
+    void start() {
+      final i = next++;
+      Future.sync(() => decoder(list[i])).then((result) {
+        results[i] = result;
+        if (++done == list.length) {
+          completer.complete(results.cast<T>());
+        } else if (next < list.length) {
+          start();
+        }
+      }, onError: (Object error, StackTrace stack) {
+        if (!completer.isCompleted) completer.completeError(error, stack);
+      });
+    }
+
+    if (list.isEmpty) return Future.value(<T>[]);
+    final workers = concurrency < 1 ? 1 : concurrency;
+    for (var i = 0; i < workers && next < list.length; ++i) {
+      start();
+    }
+    return completer.future;
+  }
+
   /// A hint from the loader to make it easier for applications
   /// to determine the type of embedded textures.
   ///
@@ -0,0 +1,339 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'bindings.dart';
+import 'extensions.dart';
+import 'mesh.dart';
+
+/// The kind of per-vertex data a [VertexAttribute] holds.
+enum VertexSemantic {
+  position,
+  normal,
+  tangent,
+  bitangent,
+  textureCoord,
+  color,
+  joints,
+  weights,
+}
+
+/// The storage format of the components of a [VertexAttribute].
+enum VertexFormat {
+  /// 32-bit IEEE float.
+  float32,
+
+  /// 16-bit IEEE half float.
+  float16,
+
+  /// 16-bit signed integer, normalized from [-1, 1].
+  snorm16,
+
+  /// 16-bit unsigned integer, normalized from [0, 1].
+  unorm16,
+
+  /// 8-bit unsigned integer, normalized from [0, 1].
+  unorm8,
+
+  /// 16-bit unsigned integer, for joint indices.
+  uint16,
+
+  /// 8-bit unsigned integer, for joint indices.
+  uint8,
+}
+
+/// A single attribute in a [VertexLayout].
+class VertexAttribute {
+  /// Creates an attribute for [semantic] stored in the given [format].
+  ///
+  /// The [index] selects the color set or UV channel. The number of
+  /// [components] defaults to 3 for positions, normals, tangents and
+  /// bitangents, 2 for texture coordinates and 4 for colors, joints and
+  /// weights. For joints and weights it is the number of influences per
+  /// vertex.
+  const VertexAttribute(this.semantic,
+      {this.format = VertexFormat.float32, this.index = 0, int? components})
+      : _components = components;
+
+  /// The kind of data.
+  final VertexSemantic semantic;
+
+  /// The storage format of each component.
+  final VertexFormat format;
+
+  /// The color set or UV channel.
+  final int index;
+
+  final int? _components;
+
+  /// The number of components.
+  int get components => _components ?? _defaultComponents[semantic.index];
+
+  /// The size of the attribute, in bytes.
+  int get size => components * _formatSizes[format.index];
+
+  static const _defaultComponents = [3, 3, 3, 3, 2, 4, 4, 4];
+  static const _formatSizes = [4, 2, 2, 2, 1, 2, 1];
+}
+
+/// Describes how vertex attributes are interleaved in a vertex buffer.
+///
+/// Attributes are laid out in the given order. Each attribute starts at a
+/// 4-byte aligned offset, as required by most graphics APIs.
+class VertexLayout {
+  /// Creates a layout of [attributes].
+  ///
+  /// The [stride] defaults to the packed size of the attributes and must not
+  /// be less than that.
+  VertexLayout(List<VertexAttribute> attributes, {int? stride})
+      : attributes = List.unmodifiable(attributes),
+        offsets = List.unmodifiable(_offsets(attributes)),
+        stride = stride ?? _size(attributes) {
+    if (this.stride < _size(attributes)) {
+      throw ArgumentError.value(stride, 'stride', 'Too small for attributes');
+    }
+  }
+
+  /// The attributes, in layout order.
+  final List<VertexAttribute> attributes;
+
+  /// The byte offset of each attribute within a vertex.
+  final List<int> offsets;
+
+  /// The distance between consecutive vertices, in bytes.
+  final int stride;
+
+  static int _align(int offset) => (offset + 3) & ~3;
+
+  static List<int> _offsets(List<VertexAttribute> attributes) {
+    final offsets = <int>[];
+    var offset = 0;
+    for (final attribute in attributes) {
+      offsets.add(offset);
+      offset = _align(offset + attribute.size);
+    }
+    return offsets;
+  }
+
+  static int _size(List<VertexAttribute> attributes) {
+    var size = 0;
+    for (final attribute in attributes) {
+      size = _align(size + attribute.size);
+    }
+    return size;
+  }
+}
+
+/// Builds interleaved vertex buffers from meshes.
+extension MeshInterleave on Mesh {
+  /// Writes the vertices of this mesh into a single interleaved buffer as
+  /// described by [layout].
+  ///
+  /// Writes into [buffer] at [offset] if given, otherwise allocates a new
+  /// buffer. To fill native memory directly, pass a view such as
+  /// `pointer.asTypedList(size).buffer.asByteData()`. Values are stored in
+  /// host byte order. Attributes that the mesh lacks are filled with zeros.
+  ///
+  /// Throws an [ArgumentError] if [buffer] is too small.
+  ByteData interleave(VertexLayout layout, {ByteData? buffer, int offset = 0}) {
+    final mesh = ptr.ref;
+    final count = mesh.mNumVertices;
+    final size = count * layout.stride;
+    buffer ??= ByteData(offset + size);
+    if (buffer.lengthInBytes < offset + size) {
+      throw ArgumentError.value(buffer, 'buffer', 'Too small for $size bytes');
+    }
+    SkinData? skin;
+    for (var a = 0; a < layout.attributes.length; ++a) {
+      final attribute = layout.attributes[a];
+      final writer = _VertexWriter(buffer, offset + layout.offsets[a],
+          layout.stride, count, attribute.components, attribute.format);
+      switch (attribute.semantic) {
+        case VertexSemantic.position:
+          writer.write(vertexData, 3);
+          break;
+        case VertexSemantic.normal:
+          writer.write(normalData, 3);
+          break;
+        case VertexSemantic.tangent:
+          writer.write(tangentData, 3);
+          break;
+        case VertexSemantic.bitangent:
+          writer.write(bitangentData, 3);
+          break;
+        case VertexSemantic.textureCoord:
+          final channel = attribute.index;
+          Float32List? coords;
+          if (channel < AI_MAX_NUMBER_OF_TEXTURECOORDS &&
+              AssimpPointer.isNotNull(mesh.mTextureCoords[channel])) {
+            coords = mesh.mTextureCoords[channel]
+                .cast<Float>()
+                .asTypedList(count * 3);
+          }
+          writer.write(coords, 3);
+          break;
+        case VertexSemantic.color:
+          writer.write(colorData(attribute.index), 4);
+          break;
+        case VertexSemantic.joints:
+          skin ??= skinData(maxInfluences: attribute.components);
+          writer.writeInts(skin.joints, skin.influences);
+          break;
+        case VertexSemantic.weights:
+          skin ??= skinData(maxInfluences: attribute.components);
+          writer.write(skin.weights, skin.influences);
+          break;
+      }
+    }
+    return buffer;
+  }
+}
+
+class _VertexWriter {
+  final ByteData buffer;
+  final int offset;
+  final int stride;
+  final int count;
+  final int components;
+  final VertexFormat format;
+
+  _VertexWriter(this.buffer, this.offset, this.stride, this.count,
+      this.components, this.format);
+
+  // Writes [components] values per vertex from [source], which holds
+  // [sourceStride] floats per vertex; missing components are written as 0.
+  void write(Float32List? source, int sourceStride) {
+    final n = source != null ? math.min(components, sourceStride) : 0;
+    for (var c = 0; c < components; ++c) {
+      var at = offset + c * _componentSize;
+      if (c >= n) {
+        for (var i = 0; i < count; ++i, at += stride) {
+          _store(at, 0);
+        }
+        continue;
+      }
+      for (var i = 0, j = c; i < count; ++i, j += sourceStride, at += stride) {
+        _store(at, source![j]);
+      }
+    }
+  }
+
+  void writeInts(Uint16List source, int sourceStride) {
+    final n = math.min(components, sourceStride);
+    for (var c = 0; c < components; ++c) {
+      var at = offset + c * _componentSize;
+      for (var i = 0, j = c; i < count; ++i, j += sourceStride, at += stride) {
+        final value = c < n ? source[j] : 0;
+        switch (format) {
+          case VertexFormat.uint8:
+            buffer.setUint8(at, value);
+            break;
+          case VertexFormat.uint16:
+            buffer.setUint16(at, value, Endian.host);
+            break;
+          default:
+            _store(at, value.toDouble());
+        }
+      }
+    }
+  }
+
+  int get _componentSize => VertexAttribute._formatSizes[format.index];
+
+  void _store(int at, double value) {
+    switch (format) {
+      case VertexFormat.float32:
+        buffer.setFloat32(at, value, Endian.host);
+        break;
+      case VertexFormat.float16:
+        buffer.setUint16(at, _toHalfFloat(value), Endian.host);
+        break;
+      case VertexFormat.snorm16:
+        final v = (value.clamp(-1.0, 1.0) * 32767).round();
+        buffer.setInt16(at, v, Endian.host);
+        break;
+      case VertexFormat.unorm16:
+        final v = (value.clamp(0.0, 1.0) * 65535).round();
+        buffer.setUint16(at, v, Endian.host);
+        break;
+      case VertexFormat.unorm8:
+        buffer.setUint8(at, (value.clamp(0.0, 1.0) * 255).round());
+        break;
+      case VertexFormat.uint16:
+        final v = value.round().clamp(0, 0xffff).toInt();
+        buffer.setUint16(at, v, Endian.host);
+        break;
+      case VertexFormat.uint8:
+        buffer.setUint8(at, value.round().clamp(0, 0xff).toInt());
+        break;
+    }
+  }
+}
+
+final _halfScratch = ByteData(4);
+
+// Converts [value] to the bits of the nearest IEEE 754 half float.
+int _toHalfFloat(double value) {
+  _halfScratch.setFloat32(0, value);
+  final bits = _halfScratch.getUint32(0);
+  final sign = (bits >> 16) & 0x8000;
+  final exponent = (bits >> 23) & 0xff;
+  var mantissa = bits & 0x7fffff;
+  if (exponent == 0xff) {
+    return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+  }
+  final e = exponent - 127 + 15;
+  if (e >= 0x1f) return sign | 0x7c00;
+  if (e <= 0) {
+    if (e < -10) return sign;
+    mantissa |= 0x800000;
+    final shift = 14 - e;
+    final half = mantissa >> shift;
+    return sign | (half + ((mantissa >> (shift - 1)) & 1));
+  }
+  final half = sign | (e << 10) | (mantissa >> 13);
+  return half + ((mantissa >> 12) & 1);
+}
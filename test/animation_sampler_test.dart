@@ -0,0 +1,173 @@
+import 'dart:ffi';
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'package:assimp/src/bindings.dart';
+import 'test_utils.dart';
+
+// Allocates a single-channel animation of 10 ticks that moves from x = 0 to
+// x = 10 and rotates 90 degrees around z, constant before and repeating
+// after the keys.
+Pointer<aiAnimation> _allocAnimation() {
+  final positions = calloc<aiVectorKey>(2);
+  final rotations = calloc<aiQuatKey>(2);
+  final scalings = calloc<aiVectorKey>(2);
+  for (var i = 0; i < 2; ++i) {
+    positions[i].mTime = rotations[i].mTime = scalings[i].mTime = i * 10.0;
+    positions[i].mValue.x = i * 10.0;
+    scalings[i].mValue
+      ..x = 1
+      ..y = 1
+      ..z = 1;
+  }
+  rotations[0].mValue.w = 1;
+  rotations[1].mValue
+    ..w = sqrt1_2
+    ..z = sqrt1_2;
+
+  final channel = calloc<aiNodeAnim>();
+  channel.ref
+    ..mNumPositionKeys = 2
+    ..mPositionKeys = positions
+    ..mNumRotationKeys = 2
+    ..mRotationKeys = rotations
+    ..mNumScalingKeys = 2
+    ..mScalingKeys = scalings
+    ..mPreState = aiAnimBehaviour.aiAnimBehaviour_CONSTANT
+    ..mPostState = aiAnimBehaviour.aiAnimBehaviour_REPEAT;
+  final channels = calloc<Pointer<aiNodeAnim>>();
+  channels.value = channel;
+
+  final animation = calloc<aiAnimation>();
+  animation.ref
+    ..mDuration = 10
+    ..mTicksPerSecond = 1
+    ..mNumChannels = 1
+    ..mChannels = channels;
+  return animation;
+}
+
+void _freeAnimation(Pointer<aiAnimation> animation) {
+  final channel = animation.ref.mChannels.value;
+  calloc.free(channel.ref.mPositionKeys);
+  calloc.free(channel.ref.mRotationKeys);
+  calloc.free(channel.ref.mScalingKeys);
+  calloc.free(channel);
+  calloc.free(animation.ref.mChannels);
+  calloc.free(animation);
+}
+
+void main() {
+  prepareTest();
+
+  test('keys', () {
+    testScene('huesitos.fbx', (scene) {
+      final animation = scene.animations.first as Animation;
+      final sampler = AnimationSampler(animation);
+      expect(sampler.channelCount, equals(animation.channels.length));
+      expect(sampler.channelNames,
+          equals(animation.channels.map((channel) => channel.name)));
+
+      final channels = animation.channels.toList();
+      for (var c = 0; c < channels.length; ++c) {
+        for (final key in channels[c].positionKeys) {
+          final data = sampler.sample(key.time);
+          expect(data[c * 10 + 0], closeTo(key.value.x, 1e-5));
+          expect(data[c * 10 + 1], closeTo(key.value.y, 1e-5));
+          expect(data[c * 10 + 2], closeTo(key.value.z, 1e-5));
+          final q = Quaternion(
+              data[c * 10 + 3], data[c * 10 + 4], data[c * 10 + 5], data[c * 10 + 6]);
+          expect(q.length, closeTo(1.0, 1e-5));
+        }
+      }
+    });
+  });
+
+  test('cursor', () {
+    testScene('lib.dae', (scene) {
+      for (final Animation animation in scene.animations) {
+        final sequential = AnimationSampler(animation);
+        final random = Random(0);
+        for (var i = 0; i <= 100; ++i) {
+          final time = animation.duration * i / 100;
+          final expected = AnimationSampler(animation).sample(time);
+          expect(sequential.sample(time), equals(expected));
+          final jump = animation.duration * random.nextDouble();
+          expect(sequential.sample(jump),
+              equals(AnimationSampler(animation).sample(jump)));
+        }
+      }
+    });
+  });
+
+  test('matrix', () {
+    testScene('huesitos.fbx', (scene) {
+      final animation = scene.animations.first as Animation;
+      final trs = AnimationSampler(animation);
+      final matrices =
+          AnimationSampler(animation, layout: SampleLayout.matrix);
+      expect(matrices.stride, equals(16));
+      final time = animation.duration / 3;
+      final a = trs.sample(time);
+      final b = matrices.sample(time, Float32List(matrices.channelCount * 16));
+      for (var c = 0; c < trs.channelCount; ++c) {
+        final o = c * 10;
+        final expected = Matrix4.compose(
+            Vector3(a[o], a[o + 1], a[o + 2]),
+            Quaternion(a[o + 3], a[o + 4], a[o + 5], a[o + 6]),
+            Vector3(a[o + 7], a[o + 8], a[o + 9]));
+        for (var k = 0; k < 16; ++k) {
+          expect(b[c * 16 + k], closeTo(expected.storage[k], 1e-4));
+        }
+      }
+    });
+  });
+
+  test('out of range', () {
+    testScene('huesitos.fbx', (scene) {
+      final animation = scene.animations.first as Animation;
+      final sampler = AnimationSampler(animation, root: scene.rootNode);
+      final channels = animation.channels.toList();
+      final before = sampler.sample(-1e6);
+      final after = sampler.sample(1e6);
+      for (var c = 0; c < channels.length; ++c) {
+        final keys = channels[c].positionKeys.toList();
+        if (keys.isEmpty) continue;
+        if (channels[c].preState == AnimBehavior.constant) {
+          expect(before[c * 10], closeTo(keys.first.value.x, 1e-5));
+        }
+        if (channels[c].postState == AnimBehavior.constant) {
+          expect(after[c * 10], closeTo(keys.last.value.x, 1e-5));
+        }
+      }
+      expect(before.every((value) => value.isFinite), isTrue);
+      expect(after.every((value) => value.isFinite), isTrue);
+    });
+  });
+
+  test('constant and repeat', () {
+    final native = _allocAnimation();
+    final sampler = AnimationSampler(Animation.fromNative(native)!);
+    expect(sampler.channelCount, equals(1));
+
+    final before = sampler.sample(-5);
+    expect(before.sublist(0, 3), equals([0, 0, 0]));
+    expect(before.sublist(3, 7), equals([0, 0, 0, 1]));
+    expect(before.sublist(7, 10), equals([1, 1, 1]));
+
+    final after = sampler.sample(15);
+    final middle = sampler.sample(5);
+    expect(after, equals(middle));
+    expect(middle[0], closeTo(5, 1e-5));
+    expect(middle[5], closeTo(sin(pi / 8), 1e-5));
+    expect(middle[6], closeTo(cos(pi / 8), 1e-5));
+    expect(middle.sublist(7, 10), equals([1, 1, 1]));
+
+    final last = sampler.sample(10);
+    expect(last[0], closeTo(10, 1e-5));
+    expect(last[5], closeTo(sqrt1_2, 1e-5));
+    _freeAnimation(native);
+  });
+}
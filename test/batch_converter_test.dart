@@ -0,0 +1,75 @@
+import 'dart:io';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  late Directory tempDir;
+  setUp(() => tempDir = Directory.systemTemp.createTempSync());
+  tearDown(() => tempDir.deleteSync(recursive: true));
+
+  test('convert', () async {
+    final converter = BatchConverter(format: 'obj', concurrency: 2);
+    expect(converter.maxPending, equals(4));
+    final inputs = ['box.3mf', 'spider.3mf', 'huesitos.fbx', 'missing.obj'];
+    final jobs = inputs.map((input) => ConversionJob(
+        testModelPath(input), '${tempDir.path}/$input.obj',
+        flags: ProcessFlags.triangulate));
+    final results = await converter.convert(jobs).toList();
+    converter.close();
+
+    expect(results.map((result) => result.job.input),
+        unorderedEquals(inputs.map(testModelPath)));
+    for (final result in results) {
+      if (result.job.input.endsWith('missing.obj')) {
+        expect(result.succeeded, isFalse);
+        expect(result.error, isNotEmpty);
+        continue;
+      }
+      expect(result.succeeded, isTrue, reason: result.error);
+      expect(result.inputSize, equals(File(result.job.input).lengthSync()));
+      expect(result.outputSize, equals(File(result.job.output).lengthSync()));
+      expect(result.sceneSize, greaterThan(0));
+      expect(result.importTime, greaterThan(Duration.zero));
+    }
+  });
+
+  test('memory limit', () async {
+    final converter = BatchConverter(format: 'obj', memoryLimit: 1);
+    final result = await converter
+        .convert([
+          ConversionJob(testModelPath('box.3mf'), '${tempDir.path}/box.obj')
+        ])
+        .single;
+    converter.close();
+    expect(result.succeeded, isFalse);
+    expect(File(result.job.output).existsSync(), isFalse);
+  });
+
+  test('back-pressure', () async {
+    final pool = ImportPool(size: 1);
+    final converter = BatchConverter(format: 'obj', pool: pool, maxPending: 1);
+    var pulled = 0;
+    final jobs = Iterable.generate(4, (i) {
+      ++pulled;
+      return ConversionJob(
+          testModelPath('box.3mf'), '${tempDir.path}/box$i.obj');
+    });
+    final results = <ConversionResult>[];
+    final subscription = converter.convert(jobs).listen(results.add);
+    await Future.delayed(Duration.zero);
+    expect(pulled, equals(1));
+    await subscription.asFuture();
+    expect(results.length, equals(4));
+    converter.close();
+    pool.close();
+  });
+
+  test('default pool', () {
+    final converter = BatchConverter(format: 'obj');
+    expect(converter.maxPending, equals(2 * Platform.numberOfProcessors));
+    converter.close();
+  });
+}
@@ -0,0 +1,82 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('lists', () {
+    testScene('spider.obj', (scene) {
+      final cached = scene.cached();
+      expect(identical(cached, scene.cached()), isTrue);
+      expect(identical(cached.meshes, cached.meshes), isTrue);
+      expect(cached.meshes, equals(scene.meshes.toList()));
+      expect(cached.materials, equals(scene.materials.toList()));
+      expect(identical(cached.materials[0].index, cached.materials[0].index),
+          isTrue);
+      expect(() => cached.meshes.add(cached.meshes.first),
+          throwsUnsupportedError);
+      expect(identical(cached.vertices(0), cached.vertices(0)), isTrue);
+      expect(cached.vertices(0), equals(scene.meshes.first.vertices.toList()));
+    });
+  });
+
+  test('nodes', () {
+    testScene('anims.dae', (scene) {
+      final cached = scene.cached();
+      final nodes = cached.nodes;
+      expect(nodes.first, equals(scene.rootNode));
+      expect(cached.parentOf(0), equals(-1));
+      for (var i = 1; i < nodes.length; ++i) {
+        expect(nodes[i].parent, equals(nodes[cached.parentOf(i)]));
+        expect(cached.childrenOf(cached.parentOf(i)), contains(i));
+        expect(identical(cached.nodeName(i), cached.nodeName(i)), isTrue);
+        expect(cached.nodeName(i), equals(nodes[i].name));
+      }
+      expect(identical(cached.intern('a' * 2), cached.intern('aa')), isTrue);
+    });
+  });
+
+  test('invalidate', () {
+    testScene('anims.dae', (scene) {
+      final cached = scene.cached();
+      final meshes = cached.meshes;
+      final transformation = cached.transformation(1);
+      expect(cached.isStale, isFalse);
+
+      final other = Scene.fromFile(testModelPath('anims.dae'))!;
+      final otherCached = other.cached();
+      final otherTransformation = otherCached.transformation(1);
+
+      final changed = transformation.clone()..setTranslationRaw(1, 2, 3);
+      cached.nodes[1].transformation = changed;
+      expect(cached.isStale, isFalse);
+      expect(cached.transformation(1),
+          equals(cached.nodes[1].transformation));
+      expect(cached.transformation(1), isNot(equals(transformation)));
+      expect(identical(cached.meshes, meshes), isTrue);
+      expect(identical(otherCached.transformation(1), otherTransformation),
+          isTrue);
+      other.dispose();
+
+      final before = cached.meshes;
+      scene.postProcess(ProcessFlags.triangulate);
+      expect(cached.isStale, isTrue);
+      expect(identical(cached.meshes, before), isFalse);
+    });
+  });
+
+  test('replaced root', () {
+    testScene('anims.dae', (scene) {
+      final cached = scene.cached();
+      cached.transformation(0);
+      scene.postProcess(ProcessFlags.preTransformVertices);
+      final transformation = cached.transformation(0);
+      expect(identical(cached.transformation(0), transformation), isTrue);
+
+      final changed = transformation.clone()..setTranslationRaw(1, 2, 3);
+      scene.rootNode.transformation = changed;
+      expect(cached.transformation(0), equals(changed));
+    });
+  });
+}
@@ -0,0 +1,51 @@
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('normalize', () {
+    expect(FileSystem.normalize('a/./b/../c.obj'), equals('a/c.obj'));
+    expect(FileSystem.normalize(r'.\a\b.mtl'), equals('a/b.mtl'));
+    expect(FileSystem.normalize('/a//b'), equals('/a/b'));
+  });
+
+  test('memory', () {
+    final fs = MemoryFileSystem({
+      'models/spider.obj':
+          File(testModelPath('spider.obj')).readAsBytesSync(),
+      'models/spider.mtl':
+          File(testModelPath('spider.mtl')).readAsBytesSync(),
+    });
+    final scene = Scene.fromFile('models/spider.obj', fileSystem: fs)!;
+    expect(scene.meshes.length, equals(19));
+    expect(scene.materials.length, equals(6));
+    scene.dispose();
+
+    expect(Scene.fromFile('models/missing.obj', fileSystem: fs), isNull);
+  });
+
+  test('memory write', () {
+    final fs = MemoryFileSystem();
+    final file = fs.open('out.bin', 'wb')!;
+    expect(file.write(Uint8List.fromList([1, 2, 3])), equals(3));
+    expect(file.setPosition(1), isTrue);
+    file.write(Uint8List.fromList([4]));
+    file.close();
+    expect(fs['out.bin'], equals([1, 4, 3]));
+  });
+
+  test('zip', () {
+    final fs = ZipFileSystem.fromFile(testModelPath('spider.zip'));
+    expect(fs.paths, unorderedEquals(['spider/spider.obj', 'spider/spider.mtl']));
+    final scene = Scene.fromFile('spider/spider.obj', fileSystem: fs)!;
+    expect(scene.meshes.length, equals(19));
+    expect(scene.materials.length, equals(6));
+    scene.dispose();
+
+    expect(() => ZipFileSystem(Uint8List(16)), throwsFormatException);
+  });
+}
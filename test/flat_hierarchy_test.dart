@@ -0,0 +1,71 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  void expectMatrix(Matrix4 actual, Matrix4 expected) {
+    for (var k = 0; k < 16; ++k) {
+      expect(actual.storage[k], closeTo(expected.storage[k], 1e-4));
+    }
+  }
+
+  test('flatten', () {
+    testScene('anims.dae', (scene) {
+      final flat = scene.flattenHierarchy();
+
+      final nodes = <Node>[];
+      void visit(Node node) {
+        nodes.add(node);
+        node.children.forEach(visit);
+      }
+
+      visit(scene.rootNode);
+      expect(flat.length, equals(nodes.length));
+      expect(flat.parents[0], equals(-1));
+      expect(flat.subtreeEnds[0], equals(nodes.length));
+
+      for (var i = 0; i < nodes.length; ++i) {
+        expect(flat.nameOf(i), equals(nodes[i].name));
+        final parent = flat.parents[i];
+        if (parent >= 0) {
+          expect(nodes[parent].children.map((c) => c.ptr),
+              contains(nodes[i].ptr));
+          expect(i, lessThan(flat.subtreeEnds[parent]));
+        }
+        expect(
+            flat.meshIndices.sublist(
+                flat.meshOffsets[i], flat.meshOffsets[i + 1]),
+            equals(nodes[i].meshes));
+        expectMatrix(flat.local(i), nodes[i].transformation.transposed());
+
+        var world = Matrix4.identity();
+        for (Node? node = nodes[i]; node != null; node = node.parent) {
+          world = node.transformation.transposed() * world;
+        }
+        expectMatrix(flat.world(i), world);
+      }
+    });
+  });
+
+  test('update', () {
+    testScene('anims.dae', (scene) {
+      final flat = scene.flattenHierarchy();
+      final child = flat.parents.indexOf(0);
+      expect(child, greaterThan(0));
+
+      flat.local(child).translate(1.0, 2.0, 3.0);
+      final expected = flat.worlds.toList();
+      final full = scene.flattenHierarchy();
+      full.locals.setAll(0, flat.locals);
+      full.updateWorldTransforms();
+
+      flat.updateWorldTransforms([child]);
+      expect(flat.worlds, isNot(equals(expected)));
+      for (var k = 0; k < flat.worlds.length; ++k) {
+        expect(flat.worlds[k], closeTo(full.worlds[k], 1e-4));
+      }
+    });
+  });
+}
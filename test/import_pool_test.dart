@@ -0,0 +1,69 @@
+import 'dart:io';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('importAsync', () async {
+    final scene = await Scene.importAsync(testModelPath('spider.obj'));
+    expect(scene.meshes.length, equals(19));
+    expect(scene.materials.length, equals(6));
+    scene.dispose();
+  });
+
+  test('importBytes', () async {
+    final pool = ImportPool(size: 1);
+    final bytes = File(testModelPath('box.3mf')).readAsBytesSync();
+    final scene = await pool.importBytes(bytes, hint: '3mf');
+    expect(scene.meshes.length, equals(1));
+    scene.dispose();
+    pool.close();
+  });
+
+  test('concurrent', () async {
+    final pool = ImportPool(size: 2);
+    final files = ['box.3mf', 'spider.3mf', 'spider.obj', 'huesitos.fbx'];
+    final scenes = await Future.wait(
+        files.map((file) => pool.importFile(testModelPath(file))));
+    expect(scenes.map((scene) => scene.meshes.length),
+        equals([1, 19, 19, 1]));
+    for (final scene in scenes) {
+      scene.dispose();
+    }
+    pool.close();
+  });
+
+  test('error', () async {
+    final pool = ImportPool(size: 1);
+    await expectLater(pool.importFile(testModelPath('missing.obj')),
+        throwsA(isA<ImportException>()));
+    pool.close();
+  });
+
+  test('cancel', () async {
+    final pool = ImportPool(size: 1);
+    final token = CancelToken();
+    final running = pool.importFile(testModelPath('spider.obj'));
+    final queued =
+        pool.importFile(testModelPath('spider.fbx'), cancelToken: token);
+    expect(pool.pending, equals(2));
+    token.cancel();
+    expect(pool.pending, equals(1));
+    await expectLater(queued, throwsA(isA<ImportCancelledException>()));
+    (await running).dispose();
+
+    final cancelled = CancelToken()..cancel();
+    await expectLater(
+        pool.importFile(testModelPath('box.3mf'), cancelToken: cancelled),
+        throwsA(isA<ImportCancelledException>()));
+    pool.close();
+  });
+
+  test('close', () async {
+    final pool = ImportPool(size: 1);
+    pool.close();
+    expect(() => pool.importFile(testModelPath('box.3mf')), throwsStateError);
+  });
+}
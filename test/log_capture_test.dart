@@ -0,0 +1,51 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('parse', () {
+    final message = LogMessage.parse('Warn,  T0: Unknown material');
+    expect(message.severity, equals(LogSeverity.warn));
+    expect(message.thread, equals(0));
+    expect(message.text, equals('Unknown material'));
+
+    final raw = LogMessage.parse('garbage');
+    expect(raw.severity, equals(LogSeverity.info));
+    expect(raw.text, equals('garbage'));
+  });
+
+  test('capture', () async {
+    final log = LogStream.attach(verbose: true);
+    expect(LogStream.isAttached, isTrue);
+    final messages = <LogMessage>[];
+    final timings = <TimingEvent>[];
+    log.messages.listen(messages.add);
+    log.timings.listen(timings.add);
+
+    final scene = Scene.fromFile(testModelPath('spider.obj'),
+        flags: ProcessFlags.triangulate | ProcessFlags.joinIdenticalVertices,
+        properties: {AI_CONFIG_GLOB_MEASURE_TIME: true})!;
+    scene.dispose();
+    await Future<void>.delayed(Duration.zero);
+
+    expect(messages, isNotEmpty);
+    expect(messages.where((m) => m.severity == LogSeverity.debug), isNotEmpty);
+    expect(timings.map((t) => t.region), contains('total'));
+    expect(timings.where((t) => t.step != null), isNotEmpty);
+
+    final pool = ImportPool(size: 1);
+    await expectLater(
+        pool.importFile(testModelPath('box.3mf')), throwsStateError);
+    expect(ImportPool.active, equals(0));
+
+    log.detach();
+    expect(LogStream.isAttached, isFalse);
+    final busy = pool.importFile(testModelPath('box.3mf'));
+    expect(() => LogStream.attach(), throwsStateError);
+    (await busy).dispose();
+    expect(ImportPool.active, equals(0));
+    pool.close();
+  });
+}
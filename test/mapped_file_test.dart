@@ -0,0 +1,47 @@
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('mapped file', () {
+    final path = testModelPath('box.3mf');
+    final file = MappedFile.open(path);
+    expect(file.length, equals(File(path).lengthSync()));
+    expect(file.data.asTypedList(file.length),
+        equals(File(path).readAsBytesSync()));
+    file.dispose();
+
+    expect(() => MappedFile.open(testModelPath('missing.obj')),
+        throwsA(isA<FileSystemException>()));
+  });
+
+  test('fromMappedFile', () {
+    final scene = Scene.fromMappedFile(testModelPath('spider.3mf'))!;
+    expect(scene.meshes.length, equals(19));
+    expect(scene.materials.length, equals(4));
+    scene.dispose();
+  });
+
+  test('fromNativeBuffer', () {
+    final bytes = File(testModelPath('box.3mf')).readAsBytesSync();
+    final buffer = malloc<Uint8>(bytes.length);
+    buffer.asTypedList(bytes.length).setAll(0, bytes);
+    final scene =
+        Scene.fromNativeBuffer(buffer, bytes.length, hint: '3mf')!;
+    malloc.free(buffer);
+    expect(scene.meshes.length, equals(1));
+    scene.dispose();
+  });
+
+  test('fromString', () {
+    final str = File(testModelPath('spider.obj')).readAsStringSync();
+    final scene = Scene.fromString(str, hint: 'obj')!;
+    expect(scene.meshes.length, equals(19));
+    scene.dispose();
+  });
+}
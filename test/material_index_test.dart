@@ -0,0 +1,59 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('lookup', () {
+    testScene('spider.obj', (scene) {
+      final skin = scene.materials.firstWhere(
+          (material) => material.index.getString(MaterialKey.name) == 'Skin');
+      final index = skin.index;
+      expect(identical(index, skin.index), isTrue);
+      final other = scene.materials.firstWhere((material) => material == skin);
+      expect(identical(other, skin), isFalse);
+      expect(identical(index, other.index), isTrue);
+      expect(index.keys, contains(MaterialKey.colorDiffuse));
+
+      final diffuse = index.getColorRgba(MaterialKey.colorDiffuse)!;
+      expect(diffuse.x, closeTo(0.827451, 1e-6));
+      expect(diffuse.y, closeTo(0.792157, 1e-6));
+      expect(diffuse.z, closeTo(0.772549, 1e-6));
+      expect(diffuse.w, equals(1.0));
+      expect(index.getFloat(MaterialKey.shininess), isZero);
+      expect(index.getInt(MaterialKey.name), isNull);
+      expect(index.getFloat('\$mat.missing'), isNull);
+      expect(index.contains(MaterialKey.colorDiffuse, 1), isFalse);
+
+      expect(index.textureCount(TextureType.diffuse), equals(1));
+      final texture = index.getTexture(TextureType.diffuse)!;
+      expect(texture.path, endsWith('wal67ar_small.jpg'));
+      expect(texture.uvIndex, isZero);
+      expect(texture.mapping, equals(TextureMapping.uv));
+      expect(texture.mapModeU, equals(TextureMapMode.wrap));
+      expect(index.getTexture(TextureType.diffuse, 1), isNull);
+      expect(index.getTexture(TextureType.specular), isNull);
+      expect(skin.textures(TextureType.diffuse), equals([texture.path]));
+    });
+  });
+
+  test('properties', () {
+    testScene('box.3mf', (scene) {
+      for (final material in scene.materials) {
+        final index = material.index;
+        for (final property in material.properties) {
+          expect(
+              index.contains(property.key, property.semantic, property.index),
+              isTrue);
+          if (property.value is String) {
+            expect(
+                index.getString(
+                    property.key, property.semantic, property.index),
+                equals(property.value));
+          }
+        }
+      }
+    });
+  });
+}
@@ -0,0 +1,49 @@
+import 'dart:typed_data';
+
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('deduplicate', () {
+    testScene('spider.3mf', (scene) {
+      final table = scene.buildMaterialTable();
+      expect(scene.materials.length, equals(4));
+      expect(table.length, equals(1));
+      expect(table.materialRemap, equals([0, 0, 0, 0]));
+      expect(table.meshMaterials, everyElement(isZero));
+      expect(table.data.lengthInBytes, equals(MaterialTable.stride));
+      expect(table.textures, isEmpty);
+    });
+  });
+
+  test('layout', () {
+    testScene('spider.obj', (scene) {
+      final table = scene.buildMaterialTable();
+      final materials = scene.materials.toList();
+      expect(table.length, lessThanOrEqualTo(materials.length));
+      expect(table.data.lengthInBytes,
+          equals(table.length * MaterialTable.stride));
+
+      var i = 0;
+      for (final mesh in scene.meshes) {
+        expect(table.meshMaterials[i++],
+            equals(table.materialRemap[mesh.materialIndex]));
+      }
+
+      final skin = materials.indexWhere(
+          (material) => material.index.getString(MaterialKey.name) == 'Skin');
+      final entry = table.materialRemap[skin];
+      final offset = entry * MaterialTable.stride;
+      expect(table.data.getFloat32(offset, Endian.little),
+          closeTo(0.827451, 1e-6));
+      expect(table.data.getFloat32(offset + 12, Endian.little), equals(1.0));
+      final texture = table.textureId(entry, TextureType.baseColor);
+      expect(table.textures[texture], endsWith('wal67ar_small.jpg'));
+      expect(table.textures[texture], isNot(contains('\\')));
+      expect(table.textureId(entry, TextureType.normals), equals(-1));
+    });
+  });
+}
@@ -0,0 +1,94 @@
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('round trip', () {
+    final random = Random(4);
+    const count = 1000;
+    final positions = Float32List.fromList(
+        List.generate(count * 3, (i) => random.nextDouble() * 20 - 10));
+    final normals = Float32List(count * 3);
+    for (var i = 0; i < count; ++i) {
+      final n = Vector3(random.nextDouble() - 0.5, random.nextDouble() - 0.5,
+          random.nextDouble() - 0.5)
+        ..normalize();
+      n.copyIntoArray(normals, i * 3);
+    }
+    final uvs = Float32List.fromList(
+        List.generate(count * 2, (i) => random.nextDouble()));
+    final indices =
+        Uint32List.fromList(List.generate(3000, (i) => random.nextInt(count)));
+
+    final bytes = MeshCodec.encode(positions, indices,
+        normals: normals, uvs: uvs);
+    final mesh = MeshCodec.decode(bytes);
+    expect(mesh.vertexCount, equals(count));
+    expect(mesh.indices, equals(indices));
+    expect(mesh.tangents, isNull);
+    for (var i = 0; i < count * 3; ++i) {
+      expect(mesh.positions[i], closeTo(positions[i], 20 / 65535));
+      expect(mesh.normals![i], closeTo(normals[i], 1e-3));
+    }
+    for (var i = 0; i < count * 2; ++i) {
+      expect(mesh.uvs![i], closeTo(uvs[i], 1 / 65535));
+    }
+  });
+
+  test('invalid', () {
+    final bytes = MeshCodec.encode(Float32List(3), Uint32List(3));
+    expect(MeshCodec.decode(bytes).indices, equals([0, 0, 0]));
+
+    final wrongMagic = Uint8List.fromList(bytes)..[0] = 0;
+    expect(() => MeshCodec.decode(wrongMagic), throwsFormatException);
+    final newer = Uint8List.fromList(bytes)..[4] = MeshCodec.version + 1;
+    expect(() => MeshCodec.decode(newer), throwsFormatException);
+    final truncated = Uint8List.sublistView(bytes, 0, bytes.length - 1);
+    expect(() => MeshCodec.decode(truncated), throwsFormatException);
+    final unversioned = Uint8List.fromList(bytes)
+      ..[4] = 0
+      ..[5] = 0;
+    expect(() => MeshCodec.decode(unversioned), throwsFormatException);
+    final huge = Uint8List.fromList(bytes);
+    ByteData.sublistView(huge).setUint32(8, 0x40000000, Endian.little);
+    expect(() => MeshCodec.decode(huge), throwsFormatException);
+  });
+
+  test('mesh', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'),
+        flags: ProcessFlags.triangulate |
+            ProcessFlags.joinIdenticalVertices |
+            ProcessFlags.generateBoundingBoxes)!;
+    for (final mesh in scene.meshes) {
+      final bytes = mesh.encode();
+      final decoded = MeshCodec.decode(bytes);
+      final raw = mesh.vertexData.lengthInBytes * 2 +
+          mesh.indexData.lengthInBytes;
+      expect(bytes.length, lessThan(raw));
+      expect(decoded.indices, equals(mesh.indexData));
+      final extent = mesh.aabb.max - mesh.aabb.min;
+      final positions = mesh.vertexData;
+      for (var i = 0; i < positions.length; ++i) {
+        expect(decoded.positions[i],
+            closeTo(positions[i], extent[i % 3] / 65535 + 1e-5));
+      }
+      expect(decoded.normals!.length, equals(positions.length));
+      expect(decoded.uvs!.length, equals(positions.length ~/ 3 * 2));
+    }
+    scene.dispose();
+  });
+
+  test('mixed primitives', () {
+    final scene = Scene.fromString('v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n'
+        'f 1 2 3\nl 1 4\n', hint: 'obj')!;
+    final mesh = scene.meshes.first;
+    final decoded = MeshCodec.decode(mesh.encode());
+    expect(decoded.indices, equals(mesh.triangleIndexData));
+    expect(decoded.indices.length, equals(3));
+    scene.dispose();
+  });
+}
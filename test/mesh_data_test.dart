@@ -0,0 +1,107 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('indexData', () {
+    testScene('spider.obj', (scene) {
+      for (final Mesh mesh in scene.meshes) {
+        final indices = mesh.faces.expand((face) => face.indices).toList();
+        expect(mesh.indexData, equals(indices));
+      }
+    });
+    testScene('box.3mf', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      expect(mesh.indexData.length, equals(mesh.faces.length * 3));
+    });
+  });
+
+  test('triangleIndexData', () {
+    final mixed = Scene.fromString(_mixedPrimitives, hint: 'obj')!;
+    final mesh = mixed.meshes.first;
+    expect(mesh.indexData.length, equals(5));
+    final triangles = mesh.triangleIndexData;
+    expect(triangles.length, equals(3));
+    expect(triangles, equals(mesh.faces.first.indices));
+    mixed.dispose();
+
+    final quad = Scene.fromString(_quad, hint: 'obj')!;
+    expect(() => quad.meshes.first.triangleIndexData, throwsArgumentError);
+    quad.dispose();
+  });
+
+  test('textureCoordData', () {
+    testScene('spider.obj', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      final components = mesh.uvComponents.first;
+      final data = mesh.textureCoordData(0)!;
+      expect(data.length, equals(mesh.vertices.length * components));
+      final coords = mesh.textureCoords.first.toList();
+      for (var i = 0; i < coords.length; ++i) {
+        expect(data[i * components], equals(coords[i].x));
+        if (components > 1) {
+          expect(data[i * components + 1], equals(coords[i].y));
+        }
+      }
+      expect(mesh.textureCoordData(mesh.uvComponents.length), isNull);
+    });
+  });
+
+  test('colorData', () {
+    testScene('spider.obj', (scene) {
+      for (final Mesh mesh in scene.meshes) {
+        expect(mesh.colorData(0), isNull);
+      }
+    });
+
+    final scene = Scene.fromString(_coloredTriangle, hint: 'ply')!;
+    final mesh = scene.meshes.first;
+    final colors = mesh.colorData(0)!;
+    final expected = [1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0.2];
+    expect(colors.length, equals(expected.length));
+    for (var i = 0; i < expected.length; ++i) {
+      expect(colors[i], closeTo(expected[i], 1e-6));
+    }
+    expect(mesh.colorData(1), isNull);
+    scene.dispose();
+  });
+}
+
+const _coloredTriangle = '''
+ply
+format ascii 1.0
+element vertex 3
+property float x
+property float y
+property float z
+property float red
+property float green
+property float blue
+property float alpha
+element face 1
+property list uchar int vertex_indices
+end_header
+0 0 0 1 0 0 1
+1 0 0 0 1 0 1
+0 1 0 0 0 1 0.2
+3 0 1 2
+''';
+
+const _mixedPrimitives = '''
+v 0 0 0
+v 1 0 0
+v 0 1 0
+v 0 0 1
+f 1 2 3
+l 1 4
+''';
+
+const _quad = '''
+v 0 0 0
+v 1 0 0
+v 1 1 0
+v 0 1 0
+f 1 2 3 4
+''';
@@ -0,0 +1,142 @@
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+const n = 16;
+
+Float32List gridPositions() {
+  final positions = Float32List((n + 1) * (n + 1) * 3);
+  for (var y = 0; y <= n; ++y) {
+    for (var x = 0; x <= n; ++x) {
+      final i = (y * (n + 1) + x) * 3;
+      positions[i] = x.toDouble();
+      positions[i + 1] = y.toDouble();
+    }
+  }
+  return positions;
+}
+
+Uint32List shuffledGrid() {
+  final triangles = <List<int>>[];
+  for (var y = 0; y < n; ++y) {
+    for (var x = 0; x < n; ++x) {
+      final a = y * (n + 1) + x, b = a + 1;
+      final c = a + n + 2, d = a + n + 1;
+      triangles..add([a, b, c])..add([a, c, d]);
+    }
+  }
+  triangles.shuffle(Random(3));
+  return Uint32List.fromList(triangles.expand((t) => t).toList());
+}
+
+List<String> triangleSet(Uint32List indices) {
+  final result = <String>[];
+  for (var i = 0; i < indices.length; i += 3) {
+    result.add('${indices[i]},${indices[i + 1]},${indices[i + 2]}');
+  }
+  return result..sort();
+}
+
+void main() {
+  prepareTest();
+
+  const vertexCount = (n + 1) * (n + 1);
+
+  test('vertex cache', () {
+    final indices = shuffledGrid();
+    final before = MeshOptimizer.analyzeVertexCache(indices, vertexCount);
+    final optimized = MeshOptimizer.optimizeVertexCache(indices, vertexCount);
+    final after = MeshOptimizer.analyzeVertexCache(optimized, vertexCount);
+    expect(triangleSet(optimized), equals(triangleSet(indices)));
+    expect(after.acmr, lessThan(before.acmr));
+    expect(after.acmr, lessThan(1.0));
+    expect(after.atvr, greaterThanOrEqualTo(1.0));
+  });
+
+  test('overdraw', () {
+    final positions = gridPositions();
+    final indices =
+        MeshOptimizer.optimizeVertexCache(shuffledGrid(), vertexCount);
+    final result = MeshOptimizer.optimizeOverdraw(indices, positions);
+    expect(triangleSet(result), equals(triangleSet(indices)));
+    expect(MeshOptimizer.analyzeVertexCache(result, vertexCount).acmr,
+        lessThanOrEqualTo(
+            MeshOptimizer.analyzeVertexCache(indices, vertexCount).acmr *
+                1.05));
+  });
+
+  test('vertex fetch', () {
+    final indices = Uint32List.fromList([4, 2, 0, 2, 4, 1]);
+    final remap = MeshOptimizer.optimizeVertexFetchRemap(indices, 6);
+    expect(remap, equals([2, 3, 1, MeshOptimizer.unused, 0,
+        MeshOptimizer.unused]));
+    expect(MeshOptimizer.remapIndices(indices, remap),
+        equals([0, 1, 2, 1, 0, 3]));
+    final data = Float32List.fromList([0, 1, 2, 3, 4, 5]);
+    expect(MeshOptimizer.remapVertices(data, 1, remap), equals([4, 2, 0, 1]));
+  });
+
+  test('meshlets', () {
+    final positions = gridPositions();
+    final indices =
+        MeshOptimizer.optimizeVertexCache(shuffledGrid(), vertexCount);
+    final meshlets = MeshOptimizer.buildMeshlets(indices, positions,
+        maxVertices: 32, maxTriangles: 40);
+    expect(meshlets.length, greaterThan(1));
+    final rebuilt = <int>[];
+    for (var m = 0; m < meshlets.length; ++m) {
+      final vertexOffset = meshlets.meshlets[m * 4];
+      final triangleOffset = meshlets.meshlets[m * 4 + 1];
+      final vertices = meshlets.meshlets[m * 4 + 2];
+      final triangles = meshlets.meshlets[m * 4 + 3];
+      expect(vertices, lessThanOrEqualTo(32));
+      expect(triangles, lessThanOrEqualTo(40));
+      for (var i = 0; i < triangles * 3; ++i) {
+        final local = meshlets.triangles[triangleOffset * 3 + i];
+        expect(local, lessThan(vertices));
+        rebuilt.add(meshlets.vertices[vertexOffset + local]);
+      }
+      // a flat grid faces +z
+      expect(meshlets.bounds[m * 12 + 9], closeTo(1, 1e-6));
+      expect(meshlets.bounds[m * 12 + 10], closeTo(0, 1e-3));
+      expect(meshlets.bounds[m * 12 + 3], greaterThan(0));
+    }
+    expect(rebuilt, equals(indices));
+  });
+
+  test('mesh', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'),
+        flags: ProcessFlags.triangulate | ProcessFlags.joinIdenticalVertices)!;
+    for (final mesh in scene.meshes) {
+      final result = mesh.optimize();
+      expect(result.indices.length, equals(mesh.indexData.length));
+      expect(result.after.acmr, lessThanOrEqualTo(result.before.acmr * 1.05));
+      final small = mesh.optimize(cacheSize: 8);
+      final before = MeshOptimizer.analyzeVertexCache(
+          mesh.indexData, mesh.vertexData.length ~/ 3, cacheSize: 8);
+      expect(small.before.acmr, equals(before.acmr));
+      final positions = MeshOptimizer.remapVertices(
+          Float32List.fromList(mesh.vertexData), 3, result.remap);
+      expect(positions.length, equals(result.vertexCount * 3));
+
+      final meshlets = mesh.buildMeshlets();
+      var triangles = 0;
+      for (var m = 0; m < meshlets.length; ++m) {
+        triangles += meshlets.meshlets[m * 4 + 3];
+      }
+      expect(triangles * 3, equals(mesh.indexData.length));
+    }
+    scene.dispose();
+  });
+
+  test('mixed primitives', () {
+    final scene = Scene.fromString('v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n'
+        'f 1 2 3\nl 1 4\n', hint: 'obj')!;
+    final mesh = scene.meshes.first;
+    expect(mesh.optimize().indices.length, equals(3));
+    expect(mesh.buildMeshlets().meshlets[3], equals(1));
+    scene.dispose();
+  });
+}
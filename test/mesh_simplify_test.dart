@@ -0,0 +1,113 @@
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+// A flat n x n quad grid in the xy plane, with a UV seam along x == seam
+// if given.
+MeshLod simplifyGrid(int n, double ratio, {int? seam}) {
+  final positions = <double>[];
+  final uvs = <double>[];
+  final ids = <int>[];
+  for (var y = 0; y <= n; ++y) {
+    for (var x = 0; x <= n; ++x) {
+      ids.add(positions.length ~/ 3);
+      positions.addAll([x.toDouble(), y.toDouble(), 0]);
+      uvs.addAll([x / n, y / n]);
+    }
+  }
+  // the vertices on the right side of the seam get their own UVs
+  final seamIds = <int>[];
+  if (seam != null) {
+    for (var y = 0; y <= n; ++y) {
+      seamIds.add(positions.length ~/ 3);
+      positions.addAll([seam.toDouble(), y.toDouble(), 0]);
+      uvs.addAll([0, y / n]);
+    }
+  }
+  int vertex(int x, int y, bool right) =>
+      right && x == seam ? seamIds[y] : ids[y * (n + 1) + x];
+  final indices = <int>[];
+  for (var y = 0; y < n; ++y) {
+    for (var x = 0; x < n; ++x) {
+      final right = seam != null && x >= seam;
+      final a = vertex(x, y, right), b = vertex(x + 1, y, right);
+      final c = vertex(x + 1, y + 1, right), d = vertex(x, y + 1, right);
+      indices.addAll([a, b, c, a, c, d]);
+    }
+  }
+  return MeshSimplifier.simplify(
+      Float32List.fromList(positions), Uint32List.fromList(indices),
+      uvs: Float32List.fromList(uvs), targetRatio: ratio);
+}
+
+void main() {
+  prepareTest();
+
+  test('plane', () {
+    final lod = simplifyGrid(8, 0.1);
+    expect(lod.triangleCount, lessThan(128));
+    expect(lod.error, lessThanOrEqualTo(0.01));
+    for (var i = 2; i < lod.positions.length; i += 3) {
+      expect(lod.positions[i], isZero);
+    }
+    // border vertices are locked
+    for (var i = 0; i <= 8; ++i) {
+      expect(hasVertex(lod, i.toDouble(), 0), isTrue);
+      expect(hasVertex(lod, 0, i.toDouble()), isTrue);
+    }
+    expect(lod.remap.length, equals(lod.vertexCount));
+    expect(lod.indices.every((i) => i < lod.vertexCount), isTrue);
+  });
+
+  test('seam', () {
+    final lod = simplifyGrid(8, 0.1, seam: 4);
+    for (var y = 0; y <= 8; ++y) {
+      expect(hasVertex(lod, 4, y.toDouble()), isTrue);
+    }
+  });
+
+  test('mesh', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'),
+        flags: ProcessFlags.triangulate | ProcessFlags.joinIdenticalVertices)!;
+    final mesh = scene.meshes.reduce(
+        (a, b) => a.indexData.length > b.indexData.length ? a : b);
+    final triangles = mesh.indexData.length ~/ 3;
+    final lod = mesh.simplify(0.5, 1.0);
+    expect(lod.triangleCount, lessThan(triangles));
+    expect(lod.normals!.length, equals(lod.positions.length));
+    expect(lod.uvs!.length, equals(lod.vertexCount * lod.uvComponents));
+    for (var i = 0; i < lod.vertexCount; ++i) {
+      expect(lod.positions[i * 3],
+          equals(mesh.vertexData[lod.remap[i] * 3]));
+    }
+
+    final lods = scene.generateLods([1.0, 0.25]);
+    expect(lods.length, equals(scene.meshes.length));
+    var i = 0;
+    for (final mesh in scene.meshes) {
+      expect(lods[i][0].triangleCount,
+          lessThanOrEqualTo(mesh.indexData.length ~/ 3));
+      expect(lods[i][1].triangleCount,
+          lessThanOrEqualTo(lods[i][0].triangleCount));
+      ++i;
+    }
+    scene.dispose();
+  });
+
+  test('mixed primitives', () {
+    final scene = Scene.fromString('v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n'
+        'f 1 2 3\nl 1 4\n', hint: 'obj')!;
+    final lod = scene.meshes.first.simplify(1.0);
+    expect(lod.triangleCount, equals(1));
+    expect(lod.indices.length, equals(3));
+    scene.dispose();
+  });
+}
+
+bool hasVertex(MeshLod lod, double x, double y) {
+  for (var i = 0; i < lod.positions.length; i += 3) {
+    if (lod.positions[i] == x && lod.positions[i + 1] == y) return true;
+  }
+  return false;
+}
@@ -0,0 +1,60 @@
+import 'package:ffi/ffi.dart';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('decode', () {
+    for (final value in ['', 'Bone.001', 'héllo wörld', '<DummyRootNode>']) {
+      final ptr = value.toNative();
+      expect(AssimpString.fromPointer(ptr), equals(value));
+      expect(AssimpString.fromNative(ptr.ref), equals(value));
+      calloc.free(ptr);
+    }
+  });
+
+  test('intern', () {
+    final table = NameTable();
+    expect(table.intern('a'), equals(0));
+    expect(table.intern('b'), equals(1));
+    expect(table.intern('a'), equals(0));
+    expect(table.idOf('b'), equals(1));
+    expect(table.idOf('c'), equals(-1));
+    expect(table.contains('c'), isFalse);
+    expect(table.nameOf(1), equals('b'));
+    expect(table.names, equals(['a', 'b']));
+    expect(identical(table.names, table.names), isTrue);
+    expect(table.length, equals(2));
+  });
+
+  test('scene', () {
+    testScene('anims.dae', (scene) {
+      final cached = scene.cached();
+      final table = cached.names;
+      expect(identical(table, cached.names), isTrue);
+      expect(table.idOf(scene.rootNode.name), equals(0));
+      for (final node in cached.nodes) {
+        expect(table.nameOf(table.idOf(node.name)), equals(node.name));
+      }
+      final flat = scene.flattenHierarchy();
+      final shared = FlatHierarchy.fromNode(scene.rootNode, names: table);
+      expect(identical(shared.nameTable, table), isTrue);
+      for (var i = 0; i < flat.length; ++i) {
+        expect(flat.nameIds[i], equals(table.idOf(flat.nameOf(i))));
+        expect(shared.nameIds[i], equals(flat.nameIds[i]));
+      }
+      for (final animation in scene.animations) {
+        for (final channel in animation.channels) {
+          expect(table.contains(channel.name), isTrue);
+        }
+      }
+      for (final mesh in scene.meshes) {
+        for (final bone in mesh.bones) {
+          expect(table.contains(bone.name), isTrue);
+        }
+      }
+    });
+  });
+}
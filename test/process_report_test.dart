@@ -0,0 +1,38 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('profilePostProcess', () {
+    testScene('spider.obj', (scene) {
+      final report = scene.profilePostProcess(
+          ProcessFlags.joinIdenticalVertices |
+              ProcessFlags.triangulate |
+              ProcessFlags.calculateTangentSpace |
+              ProcessFlags.improveCacheLocality);
+      expect(report.failed, isFalse);
+      expect(report.steps.map((step) => step.name), [
+        'triangulate',
+        'calculateTangentSpace',
+        'joinIdenticalVertices',
+        'improveCacheLocality',
+      ]);
+      for (var i = 1; i < report.steps.length; ++i) {
+        expect(report.steps[i].before.vertices,
+            equals(report.steps[i - 1].after!.vertices));
+      }
+      final join = report.steps[2];
+      expect(join.after!.vertices, lessThan(join.before.vertices));
+      expect(join.after!.faces, equals(join.before.faces));
+      expect(report.time, greaterThan(Duration.zero));
+      expect(report.slowest.length, equals(4));
+      expect(report.toString(), contains('joinIdenticalVertices'));
+
+      final stats = SceneStats.of(scene);
+      expect(stats.vertices, equals(report.steps.last.after!.vertices));
+      expect((scene.meshes.first as Mesh).tangentData, isNotNull);
+    });
+  });
+}
@@ -0,0 +1,140 @@
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'package:vector_math/vector_math.dart'
+    show Triangle, makeOrthographicMatrix;
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('boxes', () {
+    final random = Random(1);
+    final bounds = Float32List(500 * 6);
+    for (var i = 0; i < 500; ++i) {
+      for (var k = 0; k < 3; ++k) {
+        final min = random.nextDouble() * 100;
+        bounds[i * 6 + k] = min;
+        bounds[i * 6 + 3 + k] = min + random.nextDouble() * 5;
+      }
+    }
+    final bvh = Bvh.build(bounds);
+    expect(bvh.primitives.toSet().length, equals(500));
+    expect(bvh.nodeCount, lessThan(2 * 500));
+
+    final query = Aabb3.minMax(Vector3(20, 20, 20), Vector3(40, 50, 60));
+    final found = <int>{};
+    bvh.queryAabb(query, found.add);
+    for (var i = 0; i < 500; ++i) {
+      final box = Aabb3.minMax(
+          Vector3(bounds[i * 6], bounds[i * 6 + 1], bounds[i * 6 + 2]),
+          Vector3(bounds[i * 6 + 3], bounds[i * 6 + 4], bounds[i * 6 + 5]));
+      if (box.intersectsWithAabb3(query)) expect(found, contains(i));
+    }
+
+    final frustum =
+        Frustum.matrix(makeOrthographicMatrix(0, 30, 0, 30, -30, 0));
+    final culled = <int>{};
+    bvh.queryFrustum(frustum, culled.add);
+    expect(culled, isNotEmpty);
+    expect(culled.length, lessThan(500));
+    for (var i = 0; i < 500; ++i) {
+      final box = Aabb3.minMax(
+          Vector3(bounds[i * 6], bounds[i * 6 + 1], bounds[i * 6 + 2]),
+          Vector3(bounds[i * 6 + 3], bounds[i * 6 + 4], bounds[i * 6 + 5]));
+      if (frustum.intersectsWithAabb3(box)) expect(culled, contains(i));
+    }
+  });
+
+  test('empty', () {
+    final bvh = Bvh.build(Float32List(0));
+    bvh.queryAabb(Aabb3(), (i) => fail('unexpected $i'));
+    expect(bvh.queryRay(0, 0, 0, 0, 0, 1, 10, (i) => 0), lessThan(0));
+  });
+
+  test('raycast', () {
+    testScene('spider.obj', (scene) {
+      scene.postProcess(ProcessFlags.triangulate);
+      final bvh = scene.buildBvh(triangles: true);
+      final hierarchy = scene.flattenHierarchy();
+      final meshes = scene.meshes.toList();
+      expect(bvh.length, equals(hierarchy.meshIndices.length));
+      expect(bvh.overlaps(bvh.bounds).length, equals(bvh.length));
+
+      final center = bvh.bounds.center;
+      final size = (bvh.bounds.max - bvh.bounds.min).length;
+      final random = Random(2);
+      for (var r = 0; r < 8; ++r) {
+        final target = center +
+            Vector3(random.nextDouble() - 0.5, random.nextDouble() - 0.5,
+                    random.nextDouble() - 0.5) *
+                (size / 4);
+        final origin = target + Vector3(0, 0, size);
+        final ray = Ray.originDirection(origin, Vector3(0, 0, -1));
+
+        double? expected;
+        for (var i = 0; i < bvh.length; ++i) {
+          final world = hierarchy.world(bvh.instanceNodes[i]);
+          final mesh = meshes[bvh.instanceMeshes[i]];
+          final vertices = mesh.vertexData;
+          final indices = mesh.indexData;
+          Vector3 vertex(int v) => world.transformed3(Vector3(
+              vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2]));
+          for (var t = 0; t < indices.length; t += 3) {
+            final hit = ray.intersectsWithTriangle(Triangle.points(
+                vertex(indices[t]),
+                vertex(indices[t + 1]),
+                vertex(indices[t + 2])));
+            if (hit != null && (expected == null || hit < expected)) {
+              expected = hit;
+            }
+          }
+        }
+
+        final hit = bvh.raycast(ray);
+        if (expected == null) {
+          expect(hit, isNull);
+        } else {
+          expect(hit, isNotNull);
+          expect(hit!.distance, closeTo(expected, size * 1e-5));
+          expect(hit.triangle, greaterThanOrEqualTo(0));
+        }
+
+        if (expected != null) {
+          final box = scene.buildBvh().raycast(ray);
+          expect(box!.triangle, equals(-1));
+          expect(box.distance, lessThanOrEqualTo(expected + size * 1e-5));
+        }
+      }
+
+      final min = bvh.bounds.min, max = bvh.bounds.max;
+      final all = Frustum.matrix(makeOrthographicMatrix(min.x - 1, max.x + 1,
+          min.y - 1, max.y + 1, -max.z - 1, -min.z + 1));
+      expect(bvh.cull(all).length, equals(bvh.length));
+      final away = Frustum.matrix(makeOrthographicMatrix(max.x + size,
+          max.x + size * 2, min.y, max.y, -max.z - 1, -min.z + 1));
+      expect(bvh.cull(away), isEmpty);
+    });
+  });
+
+  test('ray along a face', () {
+    final box = Float32List.fromList([0, 0, 0, 1, 1, 1]);
+    // the ray runs in the plane x = 0 and enters the box at z = 1
+    expect(Bvh.raySlab(box, 0, 0, 0.5, 2, 1 / 0, 1 / 0, -1, 10), equals(1));
+    expect(Bvh.raySlab(box, 0, 1, 1, 2, 1 / 0, 1 / 0, -1, 10), equals(1));
+    expect(Bvh.raySlab(box, 0, -0.5, 0.5, 2, 1 / 0, 1 / 0, -1, 10),
+        equals(-1));
+  });
+
+  test('mixed primitives', () {
+    final scene = Scene.fromString('v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n'
+        'f 1 2 3\nl 1 4\n', hint: 'obj')!;
+    final bvh = MeshBvh.fromMesh(scene.meshes.first);
+    expect(bvh.indices.length, equals(3));
+    final hit = bvh.raycast(Ray.originDirection(
+        Vector3(0.25, 0.25, 1), Vector3(0, 0, -1)))!;
+    expect(hit.triangle, equals(0));
+    scene.dispose();
+  });
+}
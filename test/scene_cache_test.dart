@@ -0,0 +1,86 @@
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('hits and misses', () {
+    final cache = SceneCache();
+    final a = cache.load(testModelPath('box.3mf'))!;
+    final b = cache.load(testModelPath('box.3mf'))!;
+    expect(cache.misses, equals(1));
+    expect(cache.hits, equals(1));
+    expect(b.scene.ptr, equals(a.scene.ptr));
+    expect(cache.size, greaterThan(0));
+
+    final c = cache.load(testModelPath('box.3mf'),
+        flags: ProcessFlags.triangulate)!;
+    expect(cache.misses, equals(2));
+    expect(cache.length, equals(2));
+
+    a.release();
+    b.release();
+    c.release();
+    expect(() => a.scene, throwsStateError);
+    cache.clear();
+    expect(cache.length, equals(0));
+    expect(cache.size, equals(0));
+  });
+
+  test('eviction', () {
+    final cache = SceneCache(maxBytes: 1);
+    final box = cache.load(testModelPath('box.3mf'))!;
+    final spider = cache.load(testModelPath('spider.obj'))!;
+    expect(cache.evictions, equals(0));
+    box.release();
+    expect(cache.evictions, equals(1));
+    expect(cache.length, equals(1));
+    expect(spider.scene.meshes.length, equals(19));
+    spider.release();
+    expect(cache.length, equals(0));
+  });
+
+  test('dependencies', () {
+    final dir = Directory.systemTemp.createTempSync();
+    File('${dir.path}/quad.obj').writeAsStringSync('mtllib quad.mtl\n'
+        'usemtl red\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n');
+    final mtl = File('${dir.path}/quad.mtl')
+      ..writeAsStringSync('newmtl red\nKd 1 0 0\n');
+    final cache = SceneCache();
+    cache.load('${dir.path}/quad.obj')!.release();
+    cache.load('${dir.path}/quad.obj')!.release();
+    expect(cache.hits, equals(1));
+
+    mtl.writeAsStringSync('newmtl red\nKd 0 0 1\n\n');
+    final handle = cache.load('${dir.path}/quad.obj')!;
+    expect(cache.misses, equals(2));
+    expect(cache.length, equals(1));
+    final red = handle.scene.materials.firstWhere(
+        (material) => material.index.getString(MaterialKey.name) == 'red');
+    final diffuse = red.index.getColorRgba(MaterialKey.colorDiffuse)!;
+    expect(diffuse.x, equals(0.0));
+    expect(diffuse.z, equals(1.0));
+    handle.release();
+    cache.clear();
+    dir.deleteSync(recursive: true);
+  });
+
+  test('missing', () {
+    final cache = SceneCache();
+    expect(cache.load(testModelPath('missing.obj')), isNull);
+    expect(cache.length, equals(0));
+  });
+
+  test('properties', () {
+    expect(SceneCache.canonicalProperties({'b': 1, 'a': true}),
+        equals(SceneCache.canonicalProperties({'a': true, 'b': 1})));
+    expect(SceneCache.canonicalProperties({'a': 1}),
+        isNot(equals(SceneCache.canonicalProperties({'a': 1.0}))));
+    expect(SceneCache.fnv1a64(Uint8List(0)), equals(0xcbf29ce484222325));
+    expect(SceneCache.fnv1a64(Uint8List.fromList('a'.codeUnits)),
+        equals(0xaf63dc4c8601ec8c));
+  });
+}
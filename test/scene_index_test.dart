@@ -0,0 +1,69 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('nodes', () {
+    testScene('anims.dae', (scene) {
+      final index = scene.index;
+      expect(identical(index, scene.index), isTrue);
+      final nodes = scene.cached().nodes;
+      final flat = scene.flattenHierarchy();
+      expect(index.length, equals(nodes.length));
+      expect(index.parents, equals(flat.parents));
+      for (var i = 0; i < nodes.length; ++i) {
+        final name = nodes[i].name;
+        expect(index.node(i), equals(nodes[i]));
+        expect(index.names.nameOf(index.nodeNameIds[i]), equals(name));
+        final first = nodes.indexWhere((node) => node.name == name);
+        expect(index.nodeIndexOf(name), equals(first));
+      }
+      expect(index.nodeOf(scene.rootNode.name), equals(scene.rootNode));
+      expect(index.nodeIndexOf('missing'), equals(-1));
+      expect(index.nodeOf('missing'), isNull);
+    });
+  });
+
+  test('channels', () {
+    testScene('anims.dae', (scene) {
+      final index = scene.index;
+      final animations = scene.animations.toList();
+      expect(index.channelNodes.length, equals(animations.length));
+      for (var i = 0; i < animations.length; ++i) {
+        final channels = animations[i].channels.toList();
+        expect(index.channelNodes[i].length, equals(channels.length));
+        for (var j = 0; j < channels.length; ++j) {
+          expect(index.channelNode(i, j)?.name, equals(channels[j].name));
+        }
+      }
+    });
+  });
+
+  test('bones', () {
+    testScene('huesitos.fbx', (scene) {
+      final index = scene.index;
+      final meshes = scene.meshes.toList();
+      expect(index.boneNodes.length, equals(meshes.length));
+      for (var i = 0; i < meshes.length; ++i) {
+        final bones = meshes[i].bones.toList();
+        expect(index.boneNodes[i].length, equals(bones.length));
+        for (var j = 0; j < bones.length; ++j) {
+          expect(index.boneNode(i, j)?.name, equals(bones[j].name));
+        }
+      }
+    });
+  });
+
+  test('invalidate', () {
+    testScene('anims.dae', (scene) {
+      final index = scene.index;
+      expect(identical(scene.cached().names, index.names), isTrue);
+      scene.rootNode.transformation = scene.rootNode.transformation;
+      expect(identical(index, scene.index), isTrue);
+      scene.postProcess(ProcessFlags.triangulate);
+      expect(identical(index, scene.index), isFalse);
+    });
+  });
+}
@@ -0,0 +1,43 @@
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  late Directory tempDir;
+  setUp(() => tempDir = Directory.systemTemp.createTempSync());
+  tearDown(() => tempDir.deleteSync(recursive: true));
+
+  test('round trip', () {
+    final scene = Scene.fromFile(testModelPath('huesitos.fbx'),
+        flags: ProcessFlags.triangulate | ProcessFlags.generateSmoothNormals)!;
+    final path = '${tempDir.path}/huesitos.assbin';
+    expect(scene.saveSnapshot(path), isTrue);
+
+    final header = File(path).readAsBytesSync().sublist(0, 64);
+    expect(Scene.isSnapshot(header), isTrue);
+
+    final snapshot = Scene.fromSnapshot(path)!;
+    expect(snapshot.meshes.length, equals(scene.meshes.length));
+    expect(snapshot.materials.length, equals(scene.materials.length));
+    expect(snapshot.animations.length, equals(scene.animations.length));
+    expect(snapshot.rootNode.name, equals(scene.rootNode.name));
+    final a = scene.meshes.first as Mesh;
+    final b = snapshot.meshes.first as Mesh;
+    expect(b.vertexData, equals(a.vertexData));
+    expect(b.normalData, equals(a.normalData));
+    expect(b.indexData, equals(a.indexData));
+
+    snapshot.dispose();
+    scene.dispose();
+  });
+
+  test('not a snapshot', () {
+    expect(Scene.isSnapshot(Uint8List(4)), isFalse);
+    expect(() => Scene.fromSnapshot(testModelPath('box.3mf')),
+        throwsFormatException);
+  });
+}
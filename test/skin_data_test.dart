@@ -0,0 +1,55 @@
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('skinData', () {
+    testScene('huesitos.fbx', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      final bones = mesh.bones.toList();
+      expect(bones, isNotEmpty);
+
+      final skin = mesh.skinData(maxInfluences: 4);
+      final count = mesh.vertexData.length ~/ 3;
+      expect(skin.influences, equals(4));
+      expect(skin.joints.length, equals(count * 4));
+      expect(skin.weights.length, equals(count * 4));
+
+      final expected = List.generate(count, (_) => <int, double>{});
+      for (var b = 0; b < bones.length; ++b) {
+        for (final weight in bones[b].weights) {
+          expected[weight.vertexId][b] = weight.weight;
+        }
+      }
+      for (var v = 0; v < count; ++v) {
+        final influences = expected[v];
+        if (influences.isEmpty) continue;
+        var sum = 0.0;
+        for (var i = 0; i < 4; ++i) {
+          final w = skin.weights[v * 4 + i];
+          if (i > 0) expect(w, lessThanOrEqualTo(skin.weights[v * 4 + i - 1]));
+          if (w > 0) expect(influences, contains(skin.joints[v * 4 + i]));
+          sum += w;
+        }
+        expect(sum, closeTo(1.0, 1e-5));
+      }
+    });
+  });
+
+  test('boneOffsetData', () {
+    testScene('huesitos.fbx', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      final data = mesh.boneOffsetData;
+      final bones = mesh.bones.toList();
+      expect(data.length, equals(bones.length * 16));
+      for (var b = 0; b < bones.length; ++b) {
+        final storage = bones[b].offset.transposed().storage;
+        for (var k = 0; k < 16; ++k) {
+          expect(data[b * 16 + k], equals(storage[k]));
+        }
+      }
+    });
+  });
+}
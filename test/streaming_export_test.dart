@@ -0,0 +1,115 @@
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+class _BytesSink implements StreamSink<List<int>> {
+  final builder = BytesBuilder();
+  int chunks = 0;
+  bool closed = false;
+
+  @override
+  void add(List<int> data) {
+    builder.add(data);
+    ++chunks;
+  }
+
+  @override
+  void addError(Object error, [StackTrace? stackTrace]) {}
+
+  @override
+  Future addStream(Stream<List<int>> stream) => stream.forEach(add);
+
+  @override
+  Future close() {
+    closed = true;
+    return Future.value();
+  }
+
+  @override
+  Future get done => Future.value();
+}
+
+void main() {
+  prepareTest();
+
+  test('exportToSink', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'))!;
+    final sinks = <String, _BytesSink>{};
+    expect(
+        scene.exportToSink(
+            'out/spider.obj', (path) => sinks[path] = _BytesSink(),
+            format: 'obj'),
+        isTrue);
+    expect(sinks.keys, contains('out/spider.obj'));
+    expect(sinks.keys.any((name) => name.endsWith('.mtl')), isTrue);
+    expect(sinks.values.every((sink) => sink.closed), isTrue);
+
+    final fs = MemoryFileSystem({
+      for (final entry in sinks.entries)
+        entry.key: entry.value.builder.takeBytes()
+    });
+    final exported = Scene.fromFile('out/spider.obj', fileSystem: fs)!;
+    expect(exported.meshes.length, equals(scene.meshes.length));
+    exported.dispose();
+    scene.dispose();
+  });
+
+  test('chunks', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'))!;
+    final sink = _BytesSink();
+    final fs = SinkFileSystem((_) => sink, chunkSize: 1024);
+    expect(scene.exportFile('spider.stl', format: 'stl', fileSystem: fs),
+        isTrue);
+    final bytes = sink.builder.takeBytes();
+    expect(bytes, isNotEmpty);
+    expect(sink.chunks, greaterThanOrEqualTo((bytes.length / 1024).ceil()));
+    scene.dispose();
+  });
+
+  test('seek', () {
+    final buffered = _BytesSink();
+    final fs = SinkFileSystem((_) => buffered, chunkSize: 4);
+    final file = fs.open('buffered.bin', 'wb')!;
+    expect(file.setPosition(2), isTrue);
+    file.write(Uint8List.fromList([1, 2, 3, 4, 5, 6]));
+    expect(file.setPosition(0), isTrue);
+    file.write(Uint8List.fromList([9]));
+    file.close();
+    expect(buffered.builder.takeBytes(), equals([9, 0, 1, 2, 3, 4, 5, 6]));
+    expect(buffered.chunks, equals(2));
+    expect(fs.unseekable, isEmpty);
+
+    final streamed = _BytesSink();
+    final sinkFs = SinkFileSystem((_) => streamed, chunkSize: 4);
+    final stream = sinkFs.open('streamed.bin', 'wb')!;
+    stream.write(Uint8List.fromList([1, 2, 3, 4, 5, 6]));
+    expect(stream.setPosition(6), isTrue);
+    expect(stream.setPosition(0), isFalse);
+    stream.close();
+    expect(streamed.builder.takeBytes(), equals([1, 2, 3, 4, 5, 6]));
+    expect(sinkFs.unseekable, equals(['streamed.bin']));
+  });
+
+  test('memory and directory', () {
+    final scene = Scene.fromFile(testModelPath('spider.obj'))!;
+    final memory = MemoryFileSystem();
+    expect(scene.exportFile('spider.obj', format: 'obj', fileSystem: memory),
+        isTrue);
+    expect(memory['spider.obj'], isNotNull);
+
+    final tempDir = Directory.systemTemp.createTempSync();
+    final disk = DirectoryFileSystem(tempDir.path);
+    expect(scene.exportFile('spider.obj', format: 'obj', fileSystem: disk),
+        isTrue);
+    expect(File('${tempDir.path}/spider.obj').readAsBytesSync(),
+        equals(memory['spider.obj']));
+    final exported = Scene.fromFile('spider.obj', fileSystem: disk)!;
+    expect(exported.meshes.length, equals(scene.meshes.length));
+    exported.dispose();
+    tempDir.deleteSync(recursive: true);
+    scene.dispose();
+  });
+}
@@ -0,0 +1,72 @@
+import 'dart:ffi';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'package:assimp/src/bindings.dart';
+import 'test_utils.dart';
+
+Texture allocTexture(int width, int height, List<int> bytes) {
+  final ptr = calloc<aiTexture>();
+  final data = calloc<Uint8>(bytes.length);
+  data.asTypedList(bytes.length).setAll(0, bytes);
+  ptr.ref.mWidth = width;
+  ptr.ref.mHeight = height;
+  ptr.ref.pcData = data.cast<aiTexel>();
+  return Texture.fromNative(ptr)!;
+}
+
+void freeTexture(Texture texture) {
+  calloc.free(texture.ptr.ref.pcData);
+  calloc.free(texture.ptr);
+}
+
+void main() {
+  prepareTest();
+
+  test('uncompressed', () {
+    // B, G, R, A
+    final texture = allocTexture(2, 1, [1, 2, 3, 4, 5, 6, 7, 8]);
+    expect(texture.isCompressed, isFalse);
+    expect(texture.bytes, equals([1, 2, 3, 4, 5, 6, 7, 8]));
+    expect(texture.toRgba(), equals([3, 2, 1, 4, 7, 6, 5, 8]));
+
+    final out = Uint8List(12);
+    texture.toRgba(Uint8List.sublistView(out, 1));
+    expect(out, equals([0, 3, 2, 1, 4, 7, 6, 5, 8, 0, 0, 0]));
+    expect(() => texture.toRgba(Uint8List(4)), throwsRangeError);
+
+    texture.bytes[0] = 9;
+    expect(texture.data.first.b, equals(9));
+    freeTexture(texture);
+  });
+
+  test('compressed', () {
+    final texture = allocTexture(3, 0, [0x89, 0x50, 0x4e]);
+    expect(texture.isCompressed, isTrue);
+    expect(texture.bytes, equals([0x89, 0x50, 0x4e]));
+    expect(() => texture.toRgba(), throwsStateError);
+    freeTexture(texture);
+  });
+
+  test('decodeAll', () async {
+    final textures =
+        List.generate(5, (i) => allocTexture(1, 0, [i]), growable: false);
+    var active = 0;
+    var peak = 0;
+    final results = await Texture.decodeAll<int>(textures, (texture) async {
+      if (++active > peak) peak = active;
+      await Future<void>.delayed(Duration(milliseconds: 5));
+      --active;
+      return texture.bytes[0];
+    }, concurrency: 2);
+    expect(results, equals([0, 1, 2, 3, 4]));
+    expect(peak, equals(2));
+
+    await expectLater(
+        Texture.decodeAll<int>(textures, (texture) async => throw 'bad'),
+        throwsA('bad'));
+    expect(await Texture.decodeAll<int>([], (texture) async => 0), isEmpty);
+    textures.forEach(freeTexture);
+  });
+}
@@ -0,0 +1,64 @@
+import 'dart:io';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('dependencies', () {
+    final path = testModelPath('spider.obj');
+    testScene('spider.obj', (scene) {
+      final dependencies = scene.textureDependencies(path);
+      expect(dependencies.length, equals(5));
+      for (final dependency in dependencies) {
+        expect(dependency.isEmbedded, isFalse);
+        expect(dependency.types, equals({TextureType.diffuse}));
+        expect(dependency.materials.length, equals(1));
+        expect(File(dependency.path!).existsSync(), isTrue);
+      }
+      expect(dependencies.map((d) => d.path!.split('/').last),
+          contains('wal67ar_small.jpg'));
+    });
+  });
+
+  test('prefetch', () async {
+    final path = testModelPath('spider.obj');
+    final scene = Scene.fromFile(path)!;
+    final dependencies = scene.textureDependencies(path);
+    scene.dispose();
+
+    final prefetcher = TexturePrefetcher(dependencies, concurrency: 2);
+    expect(prefetcher.paths.length, equals(5));
+    final first = dependencies.first.path!;
+    expect(await prefetcher[first], equals(File(first).readAsBytesSync()));
+    final files = await prefetcher.done;
+    expect(files.length, equals(5));
+    expect(prefetcher.errors, isEmpty);
+    expect(() => prefetcher['missing.jpg'], throwsArgumentError);
+  });
+
+  test('zero concurrency', () async {
+    final path = testModelPath('spider.obj');
+    final scene = Scene.fromFile(path)!;
+    final dependencies = scene.textureDependencies(path);
+    scene.dispose();
+
+    final prefetcher = TexturePrefetcher(dependencies, concurrency: 0);
+    expect(prefetcher.concurrency, equals(1));
+    expect((await prefetcher.done).length, equals(5));
+  });
+
+  test('missing', () async {
+    final path = testModelPath('spider.obj');
+    final scene = Scene.fromFile(path)!;
+    final dependencies = scene.textureDependencies('/nonexistent/spider.obj');
+    scene.dispose();
+
+    final prefetcher = TexturePrefetcher(dependencies);
+    expect(await prefetcher.done, isEmpty);
+    expect(prefetcher.errors.length, equals(5));
+    await expectLater(prefetcher[dependencies.first.path!],
+        throwsA(isA<FileSystemException>()));
+  });
+}
@@ -0,0 +1,93 @@
+import 'dart:typed_data';
+import 'package:test/test.dart';
+import 'package:assimp/assimp.dart';
+import 'test_utils.dart';
+
+void main() {
+  prepareTest();
+
+  test('layout', () {
+    final layout = VertexLayout([
+      VertexAttribute(VertexSemantic.position),
+      VertexAttribute(VertexSemantic.normal, format: VertexFormat.snorm16),
+      VertexAttribute(VertexSemantic.textureCoord,
+          format: VertexFormat.float16),
+      VertexAttribute(VertexSemantic.joints, format: VertexFormat.uint8),
+      VertexAttribute(VertexSemantic.weights, format: VertexFormat.unorm8),
+    ]);
+    expect(layout.offsets, equals([0, 12, 20, 24, 28]));
+    expect(layout.stride, equals(32));
+    expect(() => VertexLayout(layout.attributes, stride: 16),
+        throwsArgumentError);
+  });
+
+  test('half float', () {
+    final scene = Scene.fromString(
+        'v 0 1 -2\nv 65504 1e6 5.960464477539063e-8\nv 0 0 0\nf 1 2 3\n',
+        hint: 'obj')!;
+    final mesh = scene.meshes.first as Mesh;
+    final layout = VertexLayout([
+      VertexAttribute(VertexSemantic.position, format: VertexFormat.float16),
+    ]);
+    final data = mesh.interleave(layout);
+    final halves = [
+      for (var i = 0; i < 2; ++i)
+        for (var c = 0; c < 3; ++c)
+          data.getUint16(i * layout.stride + c * 2, Endian.host)
+    ];
+    expect(halves, equals([0x0000, 0x3c00, 0xc000, 0x7bff, 0x7c00, 0x0001]));
+    scene.dispose();
+  });
+
+  test('interleave', () {
+    testScene('spider.obj', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      final layout = VertexLayout([
+        VertexAttribute(VertexSemantic.position),
+        VertexAttribute(VertexSemantic.textureCoord),
+        VertexAttribute(VertexSemantic.color, format: VertexFormat.unorm8),
+      ]);
+      final data = mesh.interleave(layout);
+      final vertices = mesh.vertexData;
+      final coords = mesh.textureCoordData(0)!;
+      final components = mesh.uvComponents.first;
+      final count = vertices.length ~/ 3;
+      expect(data.lengthInBytes, equals(count * layout.stride));
+      for (var i = 0; i < count; ++i) {
+        final at = i * layout.stride;
+        for (var c = 0; c < 3; ++c) {
+          expect(data.getFloat32(at + c * 4, Endian.host),
+              equals(vertices[i * 3 + c]));
+        }
+        expect(data.getFloat32(at + 12, Endian.host), 
+            equals(coords[i * components]));
+        expect(data.getUint32(at + 20, Endian.host), equals(0));
+      }
+
+      final buffer = ByteData(16 + count * layout.stride);
+      expect(mesh.interleave(layout, buffer: buffer, offset: 16),
+          same(buffer));
+      expect(() => mesh.interleave(layout, buffer: ByteData(4)),
+          throwsArgumentError);
+    });
+  });
+
+  test('skin', () {
+    testScene('huesitos.fbx', (scene) {
+      final mesh = scene.meshes.first as Mesh;
+      final layout = VertexLayout([
+        VertexAttribute(VertexSemantic.joints, format: VertexFormat.uint16),
+        VertexAttribute(VertexSemantic.weights),
+      ]);
+      final data = mesh.interleave(layout);
+      final count = data.lengthInBytes ~/ layout.stride;
+      for (var i = 0; i < count; ++i) {
+        var sum = 0.0;
+        for (var c = 0; c < 4; ++c) {
+          sum += data.getFloat32(i * layout.stride + 8 + c * 4, Endian.host);
+        }
+        expect(sum, anyOf(closeTo(1.0, 1e-5), equals(0.0)));
+      }
+    });
+  });
+}
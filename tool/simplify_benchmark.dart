@@ -0,0 +1,42 @@
+// Measures the throughput of MeshSimplifier.
+//
+// Usage: dart tool/simplify_benchmark.dart [model] [ratio]
+
+import 'package:assimp/assimp.dart';
+
+void main(List<String> args) {
+  final path = args.isNotEmpty ? args[0] : 'test/models/spider.obj';
+  final ratio = args.length > 1 ? double.parse(args[1]) : 0.5;
+  final scene = Scene.fromFile(path,
+      flags: ProcessFlags.triangulate | ProcessFlags.joinIdenticalVertices);
+  if (scene == null) {
+    print('Failed to import $path');
+    return;
+  }
+
+  // warm up
+  for (final mesh in scene.meshes) {
+    mesh.simplify(ratio, 1.0);
+  }
+
+  var triangles = 0;
+  for (final mesh in scene.meshes) {
+    triangles += mesh.triangleIndexData.length ~/ 3;
+  }
+
+  var output = 0;
+  final stopwatch = Stopwatch()..start();
+  const runs = 10;
+  for (var run = 0; run < runs; ++run) {
+    for (final mesh in scene.meshes) {
+      output += mesh.simplify(ratio, 1.0).triangleCount;
+    }
+  }
+  stopwatch.stop();
+  scene.dispose();
+
+  final seconds = stopwatch.elapsedMicroseconds / 1e6;
+  final input = triangles * runs;
+  print('$path: $triangles -> ${output ~/ runs} triangles');
+  print('${(input / seconds).round()} input triangles/s');
+}